@@ -9,9 +9,13 @@
 #include <mtk/core/assert.hpp>
 #include <mtk/core/byte_cast.hpp>
 #include <mtk/core/flag_operators.hpp>
+#include <mtk/core/growable_array.hpp>
+#include <mtk/core/half.hpp>
 #include <mtk/core/iterator_traits.hpp>
 #include <mtk/core/math.hpp>
 #include <mtk/core/mem_cast.hpp>
+#include <mtk/core/memory_placement.hpp>
+#include <mtk/core/memory_resource.hpp>
 #include <mtk/core/narrow_cast.hpp>
 #include <mtk/core/not_null.hpp>
 #include <mtk/core/nullptr_exception.hpp>
@@ -22,7 +26,9 @@
 #include <mtk/core/reverse_iterators.hpp>
 #include <mtk/core/saturate_cast.hpp>
 #include <mtk/core/scope_exit.hpp>
+#include <mtk/core/small_vector.hpp>
 #include <mtk/core/span.hpp>
+#include <mtk/core/static_vector.hpp>
 #include <mtk/core/trigonometry.hpp>
 #include <mtk/core/types.hpp>
 #include <mtk/core/unique_ptr.hpp>
@@ -5,8 +5,9 @@
 //! Contains the definition of mtk::array.
 
 #include <mtk/core/assert.hpp>
+#include <mtk/core/memory_placement.hpp>
+#include <mtk/core/memory_resource.hpp>
 #include <mtk/core/types.hpp>
-#include <mtk/core/unique_ptr.hpp>
 #include <mtk/core/impl/algorithm.hpp>
 #include <mtk/core/impl/declval.hpp>
 #include <mtk/core/impl/dynamic_extent.hpp>
@@ -14,6 +15,7 @@
 #include <mtk/core/impl/swap.hpp>
 
 #include <initializer_list>
+#include <new>
 #include <type_traits>
 
 namespace mtk {
@@ -46,6 +48,24 @@ _throw_out_of_range_exception(size_t idx, size_t size);
 
 
 
+//! @brief Tag type selecting the constructors that leave trivial elements uninitialized.
+//!
+//! @code
+//! #include <mtk/core/array.hpp>
+//! @endcode
+struct for_overwrite_t
+{
+	explicit
+	for_overwrite_t() = default;
+};
+
+//! Tag selecting the constructors that leave trivial elements uninitialized.
+inline constexpr
+for_overwrite_t
+for_overwrite{};
+
+
+
 //! @brief Lightweight replacement for std::array.
 //!
 //! @code
@@ -291,6 +311,9 @@ public:
 //! @code
 //! #include <mtk/core/array.hpp>
 //! @endcode
+//!
+//! The elements are allocated from a mtk::memory_resource, mtk::new_delete_resource() unless one is given.
+//! Copies, resizes and swaps carry the resource along with the elements.
 template<class T>
 class array<T, dynamic_extent>
 {
@@ -320,17 +343,57 @@ public:
 
 	//! Constructs an empty array.
 	array() noexcept :
+		array(*mtk::new_delete_resource())
+	{ }
+
+	//! Constructs an empty array that allocates from resource.
+	explicit
+	array(memory_resource& resource) noexcept :
 		m_data(nullptr),
-		m_size(0)
+		m_size(0),
+		m_resource(&resource)
 	{ }
 
 	//! Constructs an array with size default constructed elements.
 	explicit
 	array(size_type size) :
-		m_data(size == 0 ? nullptr : mtk::make_unique<value_type[]>(size)),
-		m_size(size)
+		array(size, *mtk::new_delete_resource())
+	{ }
+
+	//! Constructs an array with size value initialized elements allocated from resource.
+	array(size_type size, memory_resource& resource) :
+		m_data(_create(size, &resource, true)),
+		m_size(size),
+		m_resource(&resource)
+	{ }
+
+	//! @brief Constructs an array with size default initialized elements.
+	//!
+	//! Trivial types are left uninitialized, every element must be written before it is read.
+	array(size_type size, for_overwrite_t) :
+		array(size, for_overwrite, *mtk::new_delete_resource())
 	{ }
 
+	//! @brief Constructs an array with size default initialized elements allocated from resource.
+	//!
+	//! Trivial types are left uninitialized, every element must be written before it is read.
+	array(size_type size, for_overwrite_t, memory_resource& resource) :
+		m_data(_create(size, &resource, false)),
+		m_size(size),
+		m_resource(&resource)
+	{ }
+
+	//! @brief Constructs an array with size value initialized elements,
+	//! initialized as selected by placement.
+	//!
+	//! See mtk::memory_placement.
+	array(size_type size, memory_placement placement) :
+		array(size, for_overwrite)
+	{
+		if (size > 0)
+			mtk::_place(m_data, size, placement);
+	}
+
 	//! Constructs an array initialized as a copy of the provided range.
 	array(std::initializer_list<value_type> ilist) :
 		array(ilist.begin(), ilist.end())
@@ -344,7 +407,18 @@ public:
 #endif
 	>
 	array(InputIter first, InputIter last) :
-		array()
+		array(first, last, *mtk::new_delete_resource())
+	{ }
+
+	//! Constructs an array allocated from resource initialized as a copy of the provided range.
+	template<class InputIter
+#ifndef MTK_DOXYGEN
+		,_void_t<decltype(*mtk::_declval<InputIter>())>* = nullptr
+		,_void_t<decltype(*(mtk::_declval<InputIter&>()++))>* = nullptr
+#endif
+	>
+	array(InputIter first, InputIter last, memory_resource& resource) :
+		array(resource)
 	{
 		if constexpr (impl_core::array::_is_subtractable<InputIter>::value)
 			this->_assign_ra_iter(first, last);
@@ -352,15 +426,22 @@ public:
 			this->_assign_input_iter(first, last);
 	}
 
+	//! The copy allocates from the same resource as other.
 	array(const array& other) :
-		array(other.begin(), other.end())
+		array(other.begin(), other.end(), *other.m_resource)
 	{ }
 
 	array(array&& other) noexcept :
 		m_data(mtk::_exchange(other.m_data, nullptr)),
-		m_size(mtk::_exchange(other.m_size, 0))
+		m_size(mtk::_exchange(other.m_size, 0)),
+		m_resource(other.m_resource)
 	{ }
 
+	~array()
+	{
+		_destroy(m_data, m_size, m_size, m_resource);
+	}
+
 	array&
 	operator=(array rhs) noexcept
 	{
@@ -453,14 +534,14 @@ public:
 	pointer
 	data() noexcept
 	{
-		return m_data.get();
+		return m_data;
 	}
 
 	//! Returns a pointer to the first element in the array.
 	const_pointer
 	data() const noexcept
 	{
-		return m_data.get();
+		return m_data;
 	}
 
 
@@ -531,6 +612,13 @@ public:
 		return static_cast<size_type>(-1) - 1;
 	}
 
+	//! Returns the resource the elements are allocated from.
+	memory_resource*
+	resource() const noexcept
+	{
+		return m_resource;
+	}
+
 	//! @brief Resizes the current array to new_size.
 	//!
 	//! If new_size < size() then the excess elements are pruned,
@@ -544,8 +632,19 @@ public:
 		if (new_size == this->size())
 			return;
 
-		array tmp(new_size);
 		const size_type transfer_size = (new_size < this->size() ? new_size : this->size());
+		if constexpr (std::is_trivially_copyable_v<value_type>) {
+			// Only the appended elements need initializing, the rest is a single byte copy.
+			array tmp(new_size, for_overwrite, *m_resource);
+			mtk::_copy_range(this->begin(), this->begin() + transfer_size, tmp.begin());
+			for (auto it = tmp.begin() + transfer_size; it != tmp.end(); ++it)
+				*it = value_type();
+
+			this->swap(tmp);
+			return;
+		}
+
+		array tmp(new_size, *m_resource);
 		if constexpr (std::is_nothrow_move_assignable_v<value_type>)
 			mtk::_move_range(this->begin(), this->begin() + transfer_size, tmp.begin());
 		else
@@ -562,14 +661,60 @@ public:
 	{
 		mtk::_swap(m_data, other.m_data);
 		mtk::_swap(m_size, other.m_size);
+		mtk::_swap(m_resource, other.m_resource);
 	}
 
 private:
+	// Allocates size elements from resource and value or default initializes them.
+	static
+	pointer
+	_create(size_type size, memory_resource* resource, bool value_initialize)
+	{
+		MTK_ASSERT(resource);
+		if (size == 0)
+			return nullptr;
+
+		const pointer ptr = static_cast<pointer>(resource->allocate(size*sizeof(value_type), alignof(value_type)));
+		if (!value_initialize && std::is_trivially_default_constructible_v<value_type>)
+			return ptr;
+
+		size_type count = 0;
+		try {
+			for (; count < size; ++count) {
+				if (value_initialize)
+					::new (static_cast<void*>(ptr + count)) value_type();
+				else
+					::new (static_cast<void*>(ptr + count)) value_type;
+			}
+		} catch (...) {
+			_destroy(ptr, count, size, resource);
+			throw;
+		}
+
+		return ptr;
+	}
+
+	// Destroys the first count elements of ptr and returns its storage for size elements to resource.
+	static
+	void
+	_destroy(pointer ptr, size_type count, size_type size, memory_resource* resource) noexcept
+	{
+		if (!ptr)
+			return;
+
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (size_type i = 0; i < count; ++i)
+				ptr[i].~value_type();
+		}
+
+		resource->deallocate(ptr, size*sizeof(value_type), alignof(value_type));
+	}
+
 	template<class InputIter>
 	void
 	_assign_input_iter(InputIter first, InputIter last)
 	{
-		array tmp(8);
+		array tmp(8, *m_resource);
 		size_type count = 0;
 		auto it = tmp.begin();
 		while (first != last) {
@@ -582,7 +727,7 @@ private:
 			*(it++) = *(first++);
 		}
 
-		array final_array(count);
+		array final_array(count, for_overwrite, *m_resource);
 		mtk::_move_range(tmp.begin(), tmp.begin() + count, final_array.begin());
 		this->swap(final_array);
 	}
@@ -592,13 +737,14 @@ private:
 	_assign_ra_iter(RAIter first, RAIter last)
 	{
 		MTK_ASSERT((last - first) >= 0);
-		array tmp(last - first);
+		array tmp(last - first, for_overwrite, *m_resource);
 		mtk::_copy_range(first, last, tmp.begin());
 		this->swap(tmp);
 	}
 
-	unique_ptr<value_type[], empty_pointer_validator> m_data;
+	pointer m_data;
 	size_type m_size;
+	memory_resource* m_resource;
 };
 
 //! @}
@@ -0,0 +1,607 @@
+#ifndef MTK_CORE_GROWABLE_ARRAY_HPP
+#define MTK_CORE_GROWABLE_ARRAY_HPP
+
+//! @file
+//! Contains mtk::growable_array
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/preprocessor.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/algorithm.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/move.hpp>
+#include <mtk/core/impl/swap.hpp>
+
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace mtk {
+
+//! @addtogroup core
+//! @{
+
+namespace impl_core {
+namespace growable_array {
+
+[[noreturn]]
+void
+_throw_out_of_range_exception(size_t idx, size_t size);
+
+// Relocating an element is a byte copy, so the storage can be grown with std::realloc.
+template<class T>
+inline constexpr
+bool
+_is_trivially_relocatable = std::is_trivially_copyable_v<T> && (alignof(T) <= alignof(std::max_align_t));
+
+} // namespace growable_array
+} // namespace impl_core
+
+
+
+//! @brief Dynamic array with spare capacity, a lightweight replacement for std::vector.
+//!
+//! @code
+//! #include <mtk/core/growable_array.hpp>
+//! @endcode
+//!
+//! Lightweight as in includes less of the standard library.
+//!
+//! Named growable_array since mtk::vector is the column vector alias of mtk::matrix.
+//!
+//! Trivially copyable elements are relocated with std::realloc when the capacity grows,
+//! other elements are moved if their move constructor is noexcept, else copied.
+template<class T>
+class growable_array
+{
+public:
+	//! typedef.
+	using value_type = T;
+	//! typedef.
+	using size_type = size_t;
+	//! typedef.
+	using difference_type = ptrdiff_t;
+	//! typedef.
+	using reference = value_type&;
+	//! typedef.
+	using const_reference = const value_type&;
+	//! typedef.
+	using pointer = value_type*;
+	//! typedef.
+	using const_pointer = const value_type*;
+	//! typedef.
+	using iterator = pointer;
+	//! typedef.
+	using const_iterator = const_pointer;
+
+
+
+	//! Constructs an empty array without allocating.
+	growable_array() noexcept :
+		m_data(nullptr),
+		m_size(0),
+		m_capacity(0)
+	{ }
+
+	//! Constructs an array with size value initialized elements.
+	explicit
+	growable_array(size_type size) :
+		growable_array()
+	{
+		this->resize(size);
+	}
+
+	//! Constructs an array with size copies of value.
+	growable_array(size_type size, const value_type& value) :
+		growable_array()
+	{
+		this->reserve(size);
+		for (size_type i = 0; i < size; ++i)
+			this->push_back(value);
+	}
+
+	//! Constructs an array initialized as a copy of the provided range.
+	growable_array(std::initializer_list<value_type> ilist) :
+		growable_array(ilist.begin(), ilist.end())
+	{ }
+
+	//! Constructs an array initialized as a copy of the provided range.
+	template<class InputIter
+#ifndef MTK_DOXYGEN
+		,_void_t<decltype(*mtk::_declval<InputIter>())>* = nullptr
+		,_void_t<decltype(*(mtk::_declval<InputIter&>()++))>* = nullptr
+#endif
+	>
+	growable_array(InputIter first, InputIter last) :
+		growable_array()
+	{
+		this->_append_range(first, last);
+	}
+
+	growable_array(const growable_array& other) :
+		growable_array()
+	{
+		this->_append_range(other.begin(), other.end());
+	}
+
+	growable_array(growable_array&& other) noexcept :
+		m_data(mtk::_exchange(other.m_data, nullptr)),
+		m_size(mtk::_exchange(other.m_size, 0)),
+		m_capacity(mtk::_exchange(other.m_capacity, 0))
+	{ }
+
+	~growable_array()
+	{
+		this->_destroy(m_data, m_data + m_size);
+		this->_deallocate(m_data);
+	}
+
+	growable_array&
+	operator=(growable_array rhs) noexcept
+	{
+		this->swap(rhs);
+		return *this;
+	}
+
+
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	reference
+	operator[](size_type pos)
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	const_reference
+	operator[](size_type pos) const
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	reference
+	at(size_type pos)
+	{
+		if (pos >= this->size())
+			mtk::impl_core::growable_array::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	const_reference
+	at(size_type pos) const
+	{
+		if (pos >= this->size())
+			mtk::impl_core::growable_array::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	reference
+	front()
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	const_reference
+	front() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	reference
+	back()
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	const_reference
+	back() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! Returns a pointer to the first element in the array.
+	pointer
+	data() noexcept
+	{
+		return m_data;
+	}
+
+	//! Returns a pointer to the first element in the array.
+	const_pointer
+	data() const noexcept
+	{
+		return m_data;
+	}
+
+
+
+	//! Returns an iterator to the beginning of the array range.
+	iterator
+	begin() noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	const_iterator
+	begin() const noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	const_iterator
+	cbegin() const noexcept
+	{
+		return this->begin();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	iterator
+	end() noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	const_iterator
+	end() const noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	const_iterator
+	cend() const noexcept
+	{
+		return this->end();
+	}
+
+
+
+	//! Returns size() == 0.
+	[[nodiscard]]
+	bool
+	empty() const noexcept
+	{
+		return (this->size() == 0);
+	}
+
+	//! Returns the number of elements in the array.
+	size_type
+	size() const noexcept
+	{
+		return m_size;
+	}
+
+	//! Returns the number of elements the array can hold before it has to reallocate.
+	size_type
+	capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	//! Returns the theoretic max number of elements possible to store in the array.
+	size_type
+	max_size() const noexcept
+	{
+		return static_cast<size_type>(-1) / sizeof(value_type);
+	}
+
+	//! @brief Makes room for at least new_capacity elements.
+	//!
+	//! Invalidates all iterators if new_capacity > capacity().
+	void
+	reserve(size_type new_capacity)
+	{
+		if (new_capacity > m_capacity)
+			this->_reallocate(new_capacity);
+	}
+
+	//! @brief Releases the unused capacity.
+	//!
+	//! Invalidates all iterators if size() != capacity().
+	void
+	shrink_to_fit()
+	{
+		if (m_size < m_capacity)
+			this->_reallocate(m_size);
+	}
+
+
+
+	//! Destroys all elements, the capacity is kept.
+	void
+	clear() noexcept
+	{
+		this->_destroy(m_data, m_data + m_size);
+		m_size = 0;
+	}
+
+	//! @brief Resizes the current array to new_size.
+	//!
+	//! If new_size < size() then the excess elements are destroyed,
+	//! else if new_size > size() then value initialized elements are appended.
+	//!
+	//! Invalidates all iterators if new_size > capacity().
+	void
+	resize(size_type new_size)
+	{
+		if (new_size <= m_size) {
+			this->_destroy(m_data + new_size, m_data + m_size);
+			m_size = new_size;
+			return;
+		}
+
+		if (new_size > m_capacity)
+			this->_reallocate(this->_grown_capacity(new_size));
+
+		for (; m_size < new_size; ++m_size)
+			::new (static_cast<void*>(m_data + m_size)) value_type();
+	}
+
+	//! @brief Appends a copy of value.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	void
+	push_back(const value_type& value)
+	{
+		this->emplace_back(value);
+	}
+
+	//! @brief Appends value.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	void
+	push_back(value_type&& value)
+	{
+		this->emplace_back(mtk::_move(value));
+	}
+
+	//! @brief Appends an element constructed from args and returns it.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	template<class... Args>
+	reference
+	emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity) {
+			// args may refer to an element, construct before the storage moves.
+			value_type value(mtk::_forward<Args>(args)...);
+			this->_reallocate(this->_grown_capacity(m_size + 1));
+			::new (static_cast<void*>(m_data + m_size)) value_type(mtk::_move(value));
+		} else {
+			::new (static_cast<void*>(m_data + m_size)) value_type(mtk::_forward<Args>(args)...);
+		}
+
+		return m_data[m_size++];
+	}
+
+	//! @brief Destroys the last element.
+	//!
+	//! @pre empty() == false.
+	void
+	pop_back()
+	{
+		MTK_ASSERT(!this->empty());
+		--m_size;
+		this->_destroy(m_data + m_size, m_data + m_size + 1);
+	}
+
+
+
+	//! Swaps the contents of this array and other.
+	void
+	swap(growable_array& other) noexcept
+	{
+		mtk::_swap(m_data, other.m_data);
+		mtk::_swap(m_size, other.m_size);
+		mtk::_swap(m_capacity, other.m_capacity);
+	}
+
+private:
+	static constexpr bool _is_trivially_relocatable = impl_core::growable_array::_is_trivially_relocatable<value_type>;
+
+	size_type
+	_grown_capacity(size_type min_capacity) const noexcept
+	{
+		return mtk::_max(min_capacity, mtk::_max(m_capacity*2, size_type(4)));
+	}
+
+	static
+	void
+	_destroy(pointer first, pointer last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (; first != last; ++first)
+				first->~value_type();
+		} else {
+			MTK_IGNORE(first, last);
+		}
+	}
+
+	static
+	void
+	_deallocate(pointer ptr) noexcept
+	{
+		if constexpr (_is_trivially_relocatable)
+			std::free(ptr);
+		else
+			::operator delete(ptr, std::align_val_t(alignof(value_type)));
+	}
+
+	// Moves the elements to storage for new_capacity elements, new_capacity >= size().
+	void
+	_reallocate(size_type new_capacity)
+	{
+		MTK_ASSERT(new_capacity >= m_size);
+
+		if constexpr (_is_trivially_relocatable) {
+			if (new_capacity == 0) {
+				std::free(m_data);
+				m_data = nullptr;
+			} else {
+				void* ptr = std::realloc(m_data, new_capacity*sizeof(value_type));
+				if (!ptr)
+					throw std::bad_alloc();
+
+				m_data = static_cast<pointer>(ptr);
+			}
+		} else {
+			pointer ptr = nullptr;
+			if (new_capacity > 0)
+				ptr = static_cast<pointer>(::operator new(new_capacity*sizeof(value_type), std::align_val_t(alignof(value_type))));
+
+			if constexpr (std::is_nothrow_move_constructible_v<value_type> || !std::is_copy_constructible_v<value_type>) {
+				for (size_type i = 0; i < m_size; ++i)
+					::new (static_cast<void*>(ptr + i)) value_type(mtk::_move(m_data[i]));
+			} else {
+				size_type i = 0;
+				try {
+					for (; i < m_size; ++i)
+						::new (static_cast<void*>(ptr + i)) value_type(static_cast<const value_type&>(m_data[i]));
+				} catch (...) {
+					this->_destroy(ptr, ptr + i);
+					this->_deallocate(ptr);
+					throw;
+				}
+			}
+
+			this->_destroy(m_data, m_data + m_size);
+			this->_deallocate(m_data);
+			m_data = ptr;
+		}
+
+		m_capacity = new_capacity;
+	}
+
+	template<class InputIter>
+	void
+	_append_range(InputIter first, InputIter last)
+	{
+		if constexpr (impl_core::array::_is_subtractable<InputIter>::value) {
+			MTK_ASSERT((last - first) >= 0);
+			const size_type count = size_type(last - first);
+			this->reserve(m_size + count);
+			if constexpr (_is_trivially_relocatable && impl_core::algorithm::_is_bulk_copyable<InputIter, pointer>) {
+				mtk::_copy_range(first, last, m_data + m_size);
+				m_size += count;
+				return;
+			}
+		}
+
+		while (first != last)
+			this->emplace_back(*(first++));
+	}
+
+	pointer m_data;
+	size_type m_size;
+	size_type m_capacity;
+};
+
+//! @}
+
+//! @brief Swaps the contents of a and b.
+//!
+//! @relates growable_array
+template<class T>
+void
+swap(growable_array<T>& a, growable_array<T>& b) noexcept
+{
+	a.swap(b);
+}
+
+//! @brief Returns true if the contents of lhs and rhs are equal, else false.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator==(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+
+	return mtk::_equal_range(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//! @brief Returns false if the contents of lhs and rhs are equal, else true.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator!=(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than rhs, else false.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator<(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	return mtk::_less_than_range(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than rhs, else false.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator>(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	return (rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than or equal to rhs, else false.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator<=(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than or equal to rhs, else false.
+//!
+//! @relates growable_array
+template<class T>
+bool
+operator>=(const growable_array<T>& lhs, const growable_array<T>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef MTK_CORE_HALF_HPP
+#define MTK_CORE_HALF_HPP
+
+//! @file
+//! Contains mtk::half and mtk::bfloat16
+
+#include <mtk/core/mem_cast.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace mtk {
+namespace impl_core {
+namespace half {
+
+inline
+std::uint16_t
+_float_to_half_bits(float val) noexcept
+{
+	const auto f = mtk::mem_cast<std::uint32_t>(val);
+	const auto sign = static_cast<std::uint16_t>((f >> 16) & 0x8000u);
+	const std::uint32_t abs = f & 0x7FFFFFFFu;
+
+	if (abs >= 0x7F800000u) {
+		const std::uint32_t nan_bits = (abs > 0x7F800000u ? (0x0200u | ((abs >> 13) & 0x03FFu)) : 0u);
+		return static_cast<std::uint16_t>(sign | 0x7C00u | nan_bits);
+	}
+
+	if (abs >= 0x477FF000u)
+		return static_cast<std::uint16_t>(sign | 0x7C00u);
+
+	if (abs < 0x38800000u) {
+		if (abs <= 0x33000000u)
+			return sign;
+
+		const std::uint32_t mant = (abs & 0x007FFFFFu) | 0x00800000u;
+		const std::uint32_t shift = 126u - (abs >> 23);
+		const std::uint32_t rem = mant & ((1u << shift) - 1u);
+		const std::uint32_t halfway = 1u << (shift - 1u);
+		std::uint32_t ret = mant >> shift;
+		if ((rem > halfway) || ((rem == halfway) && (ret & 1u)))
+			++ret;
+
+		return static_cast<std::uint16_t>(sign | ret);
+	}
+
+	std::uint32_t ret = (abs - 0x38000000u) >> 13;
+	const std::uint32_t rem = abs & 0x1FFFu;
+	if ((rem > 0x1000u) || ((rem == 0x1000u) && (ret & 1u)))
+		++ret;
+
+	return static_cast<std::uint16_t>(sign | ret);
+}
+
+inline
+float
+_half_bits_to_float(std::uint16_t val) noexcept
+{
+	const std::uint32_t sign = static_cast<std::uint32_t>(val & 0x8000u) << 16;
+	const std::uint32_t exp = (val >> 10) & 0x1Fu;
+	const std::uint32_t mant = val & 0x03FFu;
+
+	if (exp == 0x1Fu) {
+		const std::uint32_t nan_bits = (mant ? (0x00400000u | (mant << 13)) : 0u);
+		return mtk::mem_cast<float>(sign | 0x7F800000u | nan_bits);
+	}
+
+	if (exp == 0) {
+		const float ret = static_cast<float>(mant)*5.9604644775390625e-8f;
+		return (sign ? -ret : ret);
+	}
+
+	return mtk::mem_cast<float>(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+inline
+std::uint16_t
+_float_to_bfloat16_bits(float val) noexcept
+{
+	const auto f = mtk::mem_cast<std::uint32_t>(val);
+	if ((f & 0x7FFFFFFFu) > 0x7F800000u)
+		return static_cast<std::uint16_t>((f >> 16) | 0x0040u);
+
+	const std::uint32_t rounding_bias = 0x7FFFu + ((f >> 16) & 1u);
+	return static_cast<std::uint16_t>((f + rounding_bias) >> 16);
+}
+
+inline
+float
+_bfloat16_bits_to_float(std::uint16_t val) noexcept
+{
+	return mtk::mem_cast<float>(static_cast<std::uint32_t>(val) << 16);
+}
+
+
+
+template<class Derived>
+class _float16_base
+{
+public:
+	static
+	Derived
+	from_bits(std::uint16_t bits) noexcept
+	{
+		Derived ret;
+		ret.m_bits = bits;
+		return ret;
+	}
+
+	std::uint16_t
+	bits() const noexcept
+	{
+		return m_bits;
+	}
+
+	template<class T
+		,_require<std::is_arithmetic_v<T>> = 0>
+	Derived&
+	operator+=(T rhs) noexcept
+	{
+		return this->_self() = static_cast<float>(this->_self()) + static_cast<float>(rhs);
+	}
+
+	template<class T
+		,_require<std::is_arithmetic_v<T>> = 0>
+	Derived&
+	operator-=(T rhs) noexcept
+	{
+		return this->_self() = static_cast<float>(this->_self()) - static_cast<float>(rhs);
+	}
+
+	template<class T
+		,_require<std::is_arithmetic_v<T>> = 0>
+	Derived&
+	operator*=(T rhs) noexcept
+	{
+		return this->_self() = static_cast<float>(this->_self())*static_cast<float>(rhs);
+	}
+
+	template<class T
+		,_require<std::is_arithmetic_v<T>> = 0>
+	Derived&
+	operator/=(T rhs) noexcept
+	{
+		return this->_self() = static_cast<float>(this->_self()) / static_cast<float>(rhs);
+	}
+
+	Derived&
+	operator+=(Derived rhs) noexcept
+	{
+		return (*this += static_cast<float>(rhs));
+	}
+
+	Derived&
+	operator-=(Derived rhs) noexcept
+	{
+		return (*this -= static_cast<float>(rhs));
+	}
+
+	Derived&
+	operator*=(Derived rhs) noexcept
+	{
+		return (*this *= static_cast<float>(rhs));
+	}
+
+	Derived&
+	operator/=(Derived rhs) noexcept
+	{
+		return (*this /= static_cast<float>(rhs));
+	}
+
+protected:
+	constexpr
+	_float16_base() noexcept :
+		m_bits()
+	{ }
+
+	Derived&
+	_self() noexcept
+	{
+		return static_cast<Derived&>(*this);
+	}
+
+	std::uint16_t m_bits;
+};
+
+} // namespace half
+} // namespace impl_core
+
+//! @addtogroup core
+//! @{
+
+//! @brief IEEE 754 binary16 storage type.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! Intended as a storage type, all arithmetic is performed
+//! by implicitly converting to float. Conversion from float rounds to nearest even.
+//!
+//! Use mtk::convert for bulk conversions, which uses F16C or AVX-512
+//! instructions when available.
+class half :
+	public impl_core::half::_float16_base<half>
+{
+public:
+	//! Constructs a half initialized to +0.
+	constexpr
+	half() noexcept = default;
+
+	//! Constructs a half from the nearest representable value of val.
+	half(float val) noexcept
+	{
+		m_bits = impl_core::half::_float_to_half_bits(val);
+	}
+
+	//! Returns the value as a float.
+	operator float() const noexcept
+	{
+		return impl_core::half::_half_bits_to_float(m_bits);
+	}
+
+	//! Assigns the nearest representable value of val.
+	half&
+	operator=(float val) noexcept
+	{
+		m_bits = impl_core::half::_float_to_half_bits(val);
+		return *this;
+	}
+};
+
+//! @brief Brain floating point storage type.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! Consists of the upper 16 bits of a float. Intended as a storage type,
+//! all arithmetic is performed by implicitly converting to float.
+//! Conversion from float rounds to nearest even.
+//!
+//! Use mtk::convert for bulk conversions, which uses AVX2
+//! instructions when available.
+class bfloat16 :
+	public impl_core::half::_float16_base<bfloat16>
+{
+public:
+	//! Constructs a bfloat16 initialized to +0.
+	constexpr
+	bfloat16() noexcept = default;
+
+	//! Constructs a bfloat16 from the nearest representable value of val.
+	bfloat16(float val) noexcept
+	{
+		m_bits = impl_core::half::_float_to_bfloat16_bits(val);
+	}
+
+	//! Returns the value as a float.
+	operator float() const noexcept
+	{
+		return impl_core::half::_bfloat16_bits_to_float(m_bits);
+	}
+
+	//! Assigns the nearest representable value of val.
+	bfloat16&
+	operator=(float val) noexcept
+	{
+		m_bits = impl_core::half::_float_to_bfloat16_bits(val);
+		return *this;
+	}
+};
+
+static_assert(sizeof(half) == 2);
+static_assert(sizeof(bfloat16) == 2);
+static_assert(std::is_trivially_copyable_v<half>);
+static_assert(std::is_trivially_copyable_v<bfloat16>);
+
+
+
+//! @brief Converts every element in src to float and stores it in dst.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! @pre src.size() == dst.size().
+void
+convert(span<const half> src, span<float> dst);
+
+//! @brief Converts every element in src to half and stores it in dst.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! @pre src.size() == dst.size().
+void
+convert(span<const float> src, span<half> dst);
+
+//! @brief Converts every element in src to float and stores it in dst.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! @pre src.size() == dst.size().
+void
+convert(span<const bfloat16> src, span<float> dst);
+
+//! @brief Converts every element in src to bfloat16 and stores it in dst.
+//!
+//! @code
+//! #include <mtk/core/half.hpp>
+//! @endcode
+//!
+//! @pre src.size() == dst.size().
+void
+convert(span<const float> src, span<bfloat16> dst);
+
+//! @}
+
+} // namespace mtk
+
+#endif
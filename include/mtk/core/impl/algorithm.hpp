@@ -1,10 +1,71 @@
 #ifndef MTK_CORE_IMPL_ALGORITHM_HPP
 #define MTK_CORE_IMPL_ALGORITHM_HPP
 
+#include <mtk/core/types.hpp>
 #include <mtk/core/impl/move.hpp>
 #include <mtk/core/impl/swap.hpp>
 
+#include <cstring>
+#include <type_traits>
+
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define MTK_IMPL_ALGORITHM_BULK
+	#endif
+#elif defined(_MSC_VER) && (_MSC_VER >= 1925)
+	#define MTK_IMPL_ALGORITHM_BULK
+#endif
+
 namespace mtk {
+namespace impl_core {
+namespace algorithm {
+
+// The bulk paths call into the C library, which is not allowed during constant evaluation.
+constexpr
+bool
+_use_bulk() noexcept
+{
+#ifdef MTK_IMPL_ALGORITHM_BULK
+	return !__builtin_is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
+template<class Iter
+	,class Iter2>
+inline constexpr
+bool
+_is_same_pointee = std::is_pointer_v<Iter> && std::is_pointer_v<Iter2> &&
+	std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter>>, std::remove_pointer_t<Iter2>>;
+
+// Assignment is a byte copy.
+template<class Iter
+	,class Iter2>
+inline constexpr
+bool
+_is_bulk_copyable = _is_same_pointee<Iter, Iter2> &&
+	std::is_trivially_copyable_v<std::remove_pointer_t<Iter2>> &&
+	std::is_trivially_copy_assignable_v<std::remove_pointer_t<Iter2>>;
+
+// operator== compares the bytes, rules out padding, floating point and class types.
+template<class Iter>
+inline constexpr
+bool
+_is_bulk_equality_comparable = std::is_pointer_v<Iter> &&
+	std::is_scalar_v<std::remove_cv_t<std::remove_pointer_t<Iter>>> &&
+	std::has_unique_object_representations_v<std::remove_cv_t<std::remove_pointer_t<Iter>>>;
+
+// operator< orders as memcmp does, which holds for unsigned single bytes only.
+template<class Iter>
+inline constexpr
+bool
+_is_bulk_less_than_comparable = _is_bulk_equality_comparable<Iter> &&
+	(sizeof(std::remove_pointer_t<Iter>) == 1) && std::is_unsigned_v<std::remove_cv_t<std::remove_pointer_t<Iter>>>;
+
+} // namespace algorithm
+} // namespace impl_core
+
 
 template<class Iter
 	,class Iter2>
@@ -12,6 +73,14 @@ constexpr
 void
 _copy_range(Iter first, Iter last, Iter2 dst)
 {
+	if constexpr (impl_core::algorithm::_is_bulk_copyable<Iter, Iter2>) {
+		if (impl_core::algorithm::_use_bulk()) {
+			if (first != last)
+				std::memmove(dst, first, size_t(last - first)*sizeof(*first));
+			return;
+		}
+	}
+
 	while (first != last) {
 		*(dst++) = *(first++);
 	}
@@ -23,6 +92,14 @@ constexpr
 void
 _move_range(Iter first, Iter last, Iter2 dst)
 {
+	if constexpr (impl_core::algorithm::_is_bulk_copyable<Iter, Iter2>) {
+		if (impl_core::algorithm::_use_bulk()) {
+			if (first != last)
+				std::memmove(dst, first, size_t(last - first)*sizeof(*first));
+			return;
+		}
+	}
+
 	while (first != last) {
 		*(dst++) = mtk::_move(*(first++));
 	}
@@ -43,6 +120,11 @@ constexpr
 bool
 _equal_range(Iter first1, Iter last1, Iter first2)
 {
+	if constexpr (impl_core::algorithm::_is_bulk_equality_comparable<Iter>) {
+		if (impl_core::algorithm::_use_bulk())
+			return (first1 == last1) || (std::memcmp(first1, first2, size_t(last1 - first1)*sizeof(*first1)) == 0);
+	}
+
 	while (first1 != last1) {
 		if (!(*(first1++) == *(first2++)))
 			return false;
@@ -56,6 +138,16 @@ constexpr
 bool
 _less_than_range(Iter first1, Iter last1, Iter first2, Iter last2)
 {
+	if constexpr (impl_core::algorithm::_is_bulk_less_than_comparable<Iter>) {
+		if (impl_core::algorithm::_use_bulk()) {
+			const size_t size1 = size_t(last1 - first1);
+			const size_t size2 = size_t(last2 - first2);
+			const size_t size = (size1 < size2 ? size1 : size2);
+			const int cmp = (size == 0 ? 0 : std::memcmp(first1, first2, size));
+			return (cmp < 0) || ((cmp == 0) && (size1 < size2));
+		}
+	}
+
 	while ((first1 != last1) && (first2 != last2)) {
 		if (*first1 < *first2)
 			return true;
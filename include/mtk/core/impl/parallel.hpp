@@ -0,0 +1,41 @@
+#ifndef MTK_CORE_IMPL_PARALLEL_HPP
+#define MTK_CORE_IMPL_PARALLEL_HPP
+
+#include <mtk/core/types.hpp>
+
+#include <type_traits>
+
+namespace mtk {
+namespace impl_core {
+namespace parallel {
+
+using _range_fn = void(*)(void*, size_t, size_t);
+
+size_t
+_thread_count() noexcept;
+
+void
+_run(size_t count, size_t grain, _range_fn fn, void* ctx);
+
+} // namespace parallel
+} // namespace impl_core
+
+// Splits [0, count) into contiguous ranges of at least grain elements
+// and calls f(first, last) for each, one range per thread.
+// Returns after every range has been processed. If a call throws, the
+// exception of the first failing range is rethrown once all threads are joined.
+template<class F>
+void
+_parallel_for(size_t count, size_t grain, F&& f)
+{
+	using fn_type = std::remove_reference_t<F>;
+
+	auto invoke = [](void* ctx, size_t first, size_t last) {
+		(*static_cast<fn_type*>(ctx))(first, last);
+	};
+	impl_core::parallel::_run(count, grain, invoke, const_cast<void*>(static_cast<const void*>(&f)));
+}
+
+} // namespace mtk
+
+#endif
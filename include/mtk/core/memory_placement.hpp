@@ -0,0 +1,80 @@
+#ifndef MTK_CORE_MEMORY_PLACEMENT_HPP
+#define MTK_CORE_MEMORY_PLACEMENT_HPP
+
+//! @file
+//! Contains mtk::memory_placement
+
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/parallel.hpp>
+
+namespace mtk {
+
+//! @addtogroup core
+//! @{
+
+//! @brief Selects where the pages of a large allocation end up on NUMA systems.
+//!
+//! @code
+//! #include <mtk/core/memory_placement.hpp>
+//! @endcode
+//!
+//! Linux places a page on the node of the thread that first writes to it,
+//! so the thread initializing an allocation decides its placement.
+//! Non trivial types are constructed before the placement applies,
+//! so only trivially default constructible types benefit.
+enum class memory_placement
+{
+	//! Initialized by the allocating thread, all pages land on its node.
+	local,
+	//! Initialized in parallel, the pages follow the split of mtk::_parallel_for.
+	first_touch,
+	//! Pages are interleaved over all online nodes, then initialized in parallel.
+	//! Falls back to first_touch where the kernel has no memory policies.
+	interleave
+};
+
+//! @}
+
+
+
+namespace impl_core {
+namespace memory {
+
+// Bytes initialized per parallel task.
+inline constexpr
+size_t
+_parallel_grain = size_t(1) << 20;
+
+// Asks the kernel to interleave the whole pages of [ptr, ptr + bytes) over the online nodes.
+// Has no effect on single node systems or when the request is refused.
+void
+_interleave(void* ptr, size_t bytes) noexcept;
+
+} // namespace memory
+} // namespace impl_core
+
+// Value initializes ptr[0, n) as selected by placement, ptr must not have been written to yet.
+template<class T>
+void
+_place(T* ptr, size_t n, memory_placement placement)
+{
+	if (placement == memory_placement::interleave)
+		impl_core::memory::_interleave(ptr, n*sizeof(T));
+
+	if (placement == memory_placement::local) {
+		for (size_t i = 0; i < n; ++i)
+			ptr[i] = T();
+		return;
+	}
+
+	const size_t grain = mtk::_max(impl_core::memory::_parallel_grain / sizeof(T), size_t(1));
+	mtk::_parallel_for(n, grain, [ptr](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i)
+			ptr[i] = T();
+	});
+}
+
+} // namespace mtk
+
+#endif
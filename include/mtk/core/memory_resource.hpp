@@ -0,0 +1,155 @@
+#ifndef MTK_CORE_MEMORY_RESOURCE_HPP
+#define MTK_CORE_MEMORY_RESOURCE_HPP
+
+//! @file
+//! Contains mtk::memory_resource
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+
+#include <cstddef>
+
+namespace mtk {
+
+//! @addtogroup core
+//! @{
+
+//! @brief Source of raw memory for mtk::array, a lightweight replacement for std::pmr::memory_resource.
+//!
+//! @code
+//! #include <mtk/core/memory_resource.hpp>
+//! @endcode
+//!
+//! Derive from it to allocate from arenas, huge pages or other special memory.
+//! A resource must outlive every array allocated from it.
+class memory_resource
+{
+public:
+	virtual
+	~memory_resource() = default;
+
+	//! @brief Allocates at least bytes aligned to alignment, throws std::bad_alloc on failure.
+	//!
+	//! @pre alignment must be a power of 2.
+	void*
+	allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		MTK_ASSERT((alignment > 0) && ((alignment & (alignment - 1)) == 0));
+		return this->do_allocate(bytes, alignment);
+	}
+
+	//! @brief Deallocates ptr.
+	//!
+	//! @pre ptr must have been returned by allocate(bytes, alignment) of a resource equal to *this.
+	void
+	deallocate(void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept
+	{
+		this->do_deallocate(ptr, bytes, alignment);
+	}
+
+	//! Returns true if memory allocated from other can be deallocated by *this and vice versa.
+	bool
+	is_equal(const memory_resource& other) const noexcept
+	{
+		return (this == &other) || this->do_is_equal(other);
+	}
+
+protected:
+	virtual
+	void*
+	do_allocate(size_t bytes, size_t alignment) = 0;
+
+	virtual
+	void
+	do_deallocate(void* ptr, size_t bytes, size_t alignment) noexcept = 0;
+
+	virtual
+	bool
+	do_is_equal(const memory_resource& other) const noexcept
+	{
+		return (this == &other);
+	}
+};
+
+//! @brief Returns the resource using the global, alignment aware, operator new and operator delete.
+//!
+//! @code
+//! #include <mtk/core/memory_resource.hpp>
+//! @endcode
+//!
+//! Used by mtk::array when no resource is given.
+memory_resource*
+new_delete_resource() noexcept;
+
+
+
+//! @brief Raises the alignment of every allocation made through an upstream resource.
+//!
+//! @code
+//! #include <mtk/core/memory_resource.hpp>
+//! @endcode
+//!
+//! E.g. aligned_resource(64) gives cache line and AVX-512 aligned storage.
+class aligned_resource final :
+	public memory_resource
+{
+public:
+	//! @pre alignment must be a power of 2.
+	explicit
+	aligned_resource(size_t alignment, memory_resource& upstream = *mtk::new_delete_resource()) noexcept :
+		m_upstream(&upstream),
+		m_alignment(alignment)
+	{
+		MTK_ASSERT((alignment > 0) && ((alignment & (alignment - 1)) == 0));
+	}
+
+	//! Returns the minimum alignment of the allocations.
+	size_t
+	alignment() const noexcept
+	{
+		return m_alignment;
+	}
+
+	//! Returns the resource the allocations are forwarded to.
+	memory_resource*
+	upstream_resource() const noexcept
+	{
+		return m_upstream;
+	}
+
+protected:
+	void*
+	do_allocate(size_t bytes, size_t alignment) override
+	{
+		return m_upstream->allocate(bytes, this->_alignment(alignment));
+	}
+
+	void
+	do_deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override
+	{
+		m_upstream->deallocate(ptr, bytes, this->_alignment(alignment));
+	}
+
+	bool
+	do_is_equal(const memory_resource& other) const noexcept override
+	{
+		const auto* aligned = dynamic_cast<const aligned_resource*>(&other);
+		return aligned && (aligned->m_alignment == m_alignment) && aligned->m_upstream->is_equal(*m_upstream);
+	}
+
+private:
+	size_t
+	_alignment(size_t alignment) const noexcept
+	{
+		return (alignment < m_alignment ? m_alignment : alignment);
+	}
+
+	memory_resource* m_upstream;
+	size_t m_alignment;
+};
+
+//! @}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,706 @@
+#ifndef MTK_CORE_SMALL_VECTOR_HPP
+#define MTK_CORE_SMALL_VECTOR_HPP
+
+//! @file
+//! Contains mtk::small_vector
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/growable_array.hpp>
+#include <mtk/core/preprocessor.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/algorithm.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/move.hpp>
+#include <mtk/core/impl/swap.hpp>
+
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace mtk {
+
+//! @addtogroup core
+//! @{
+
+namespace impl_core {
+namespace small_vector {
+
+[[noreturn]]
+void
+_throw_out_of_range_exception(size_t idx, size_t size);
+
+} // namespace small_vector
+} // namespace impl_core
+
+
+
+//! @brief Dynamic array that keeps up to N elements inline and spills to the heap beyond that.
+//!
+//! @code
+//! #include <mtk/core/small_vector.hpp>
+//! @endcode
+//!
+//! Has the interface of mtk::growable_array, a small_vector holding at most N elements never allocates.
+//!
+//! Unlike growable_array a move has to move the elements one by one while they are stored inline,
+//! so moves and swaps are only noexcept if the element move constructor is.
+template<class T
+	,size_t N>
+class small_vector
+{
+public:
+	//! typedef.
+	using value_type = T;
+	//! typedef.
+	using size_type = size_t;
+	//! typedef.
+	using difference_type = ptrdiff_t;
+	//! typedef.
+	using reference = value_type&;
+	//! typedef.
+	using const_reference = const value_type&;
+	//! typedef.
+	using pointer = value_type*;
+	//! typedef.
+	using const_pointer = const value_type*;
+	//! typedef.
+	using iterator = pointer;
+	//! typedef.
+	using const_iterator = const_pointer;
+
+	//! Number of elements stored without allocating.
+	static constexpr size_type inline_capacity = N;
+
+
+
+	//! Constructs an empty array using the inline storage.
+	small_vector() noexcept :
+		m_data(this->_inline_data()),
+		m_size(0),
+		m_capacity(N)
+	{ }
+
+	//! Constructs an array with size value initialized elements.
+	explicit
+	small_vector(size_type size) :
+		small_vector()
+	{
+		this->resize(size);
+	}
+
+	//! Constructs an array with size copies of value.
+	small_vector(size_type size, const value_type& value) :
+		small_vector()
+	{
+		this->reserve(size);
+		for (size_type i = 0; i < size; ++i)
+			this->push_back(value);
+	}
+
+	//! Constructs an array initialized as a copy of the provided range.
+	small_vector(std::initializer_list<value_type> ilist) :
+		small_vector(ilist.begin(), ilist.end())
+	{ }
+
+	//! Constructs an array initialized as a copy of the provided range.
+	template<class InputIter
+#ifndef MTK_DOXYGEN
+		,_void_t<decltype(*mtk::_declval<InputIter>())>* = nullptr
+		,_void_t<decltype(*(mtk::_declval<InputIter&>()++))>* = nullptr
+#endif
+	>
+	small_vector(InputIter first, InputIter last) :
+		small_vector()
+	{
+		this->_append_range(first, last);
+	}
+
+	small_vector(const small_vector& other) :
+		small_vector()
+	{
+		this->_append_range(other.begin(), other.end());
+	}
+
+	small_vector(small_vector&& other)
+	noexcept(std::is_nothrow_move_constructible_v<value_type>) :
+		small_vector()
+	{
+		this->_take(other);
+	}
+
+	~small_vector()
+	{
+		this->_destroy(m_data, m_data + m_size);
+		if (!this->_is_inline())
+			this->_deallocate(m_data);
+	}
+
+	small_vector&
+	operator=(small_vector rhs)
+	noexcept(std::is_nothrow_move_constructible_v<value_type>)
+	{
+		this->swap(rhs);
+		return *this;
+	}
+
+
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	reference
+	operator[](size_type pos)
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	const_reference
+	operator[](size_type pos) const
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	reference
+	at(size_type pos)
+	{
+		if (pos >= this->size())
+			mtk::impl_core::small_vector::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	const_reference
+	at(size_type pos) const
+	{
+		if (pos >= this->size())
+			mtk::impl_core::small_vector::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	reference
+	front()
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	const_reference
+	front() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	reference
+	back()
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	const_reference
+	back() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! Returns a pointer to the first element in the array.
+	pointer
+	data() noexcept
+	{
+		return m_data;
+	}
+
+	//! Returns a pointer to the first element in the array.
+	const_pointer
+	data() const noexcept
+	{
+		return m_data;
+	}
+
+
+
+	//! Returns an iterator to the beginning of the array range.
+	iterator
+	begin() noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	const_iterator
+	begin() const noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	const_iterator
+	cbegin() const noexcept
+	{
+		return this->begin();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	iterator
+	end() noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	const_iterator
+	end() const noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	const_iterator
+	cend() const noexcept
+	{
+		return this->end();
+	}
+
+
+
+	//! Returns size() == 0.
+	[[nodiscard]]
+	bool
+	empty() const noexcept
+	{
+		return (this->size() == 0);
+	}
+
+	//! Returns the number of elements in the array.
+	size_type
+	size() const noexcept
+	{
+		return m_size;
+	}
+
+	//! Returns the number of elements the array can hold before it has to reallocate, at least N.
+	size_type
+	capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	//! Returns the theoretic max number of elements possible to store in the array.
+	size_type
+	max_size() const noexcept
+	{
+		return static_cast<size_type>(-1) / sizeof(value_type);
+	}
+
+	//! @brief Makes room for at least new_capacity elements.
+	//!
+	//! Invalidates all iterators if new_capacity > capacity().
+	void
+	reserve(size_type new_capacity)
+	{
+		if (new_capacity > m_capacity)
+			this->_reallocate(new_capacity);
+	}
+
+	//! @brief Releases the unused capacity, moves the elements back inline if size() <= N.
+	//!
+	//! Invalidates all iterators if size() != capacity().
+	void
+	shrink_to_fit()
+	{
+		if (m_size < m_capacity)
+			this->_reallocate(m_size);
+	}
+
+
+
+	//! Destroys all elements, the capacity is kept.
+	void
+	clear() noexcept
+	{
+		this->_destroy(m_data, m_data + m_size);
+		m_size = 0;
+	}
+
+	//! @brief Resizes the current array to new_size.
+	//!
+	//! If new_size < size() then the excess elements are destroyed,
+	//! else if new_size > size() then value initialized elements are appended.
+	//!
+	//! Invalidates all iterators if new_size > capacity().
+	void
+	resize(size_type new_size)
+	{
+		if (new_size <= m_size) {
+			this->_destroy(m_data + new_size, m_data + m_size);
+			m_size = new_size;
+			return;
+		}
+
+		if (new_size > m_capacity)
+			this->_reallocate(this->_grown_capacity(new_size));
+
+		for (; m_size < new_size; ++m_size)
+			::new (static_cast<void*>(m_data + m_size)) value_type();
+	}
+
+	//! @brief Appends a copy of value.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	void
+	push_back(const value_type& value)
+	{
+		this->emplace_back(value);
+	}
+
+	//! @brief Appends value.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	void
+	push_back(value_type&& value)
+	{
+		this->emplace_back(mtk::_move(value));
+	}
+
+	//! @brief Appends an element constructed from args and returns it.
+	//!
+	//! Invalidates all iterators if size() == capacity().
+	template<class... Args>
+	reference
+	emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity) {
+			// args may refer to an element, construct before the storage moves.
+			value_type value(mtk::_forward<Args>(args)...);
+			this->_reallocate(this->_grown_capacity(m_size + 1));
+			::new (static_cast<void*>(m_data + m_size)) value_type(mtk::_move(value));
+		} else {
+			::new (static_cast<void*>(m_data + m_size)) value_type(mtk::_forward<Args>(args)...);
+		}
+
+		return m_data[m_size++];
+	}
+
+	//! @brief Destroys the last element.
+	//!
+	//! @pre empty() == false.
+	void
+	pop_back()
+	{
+		MTK_ASSERT(!this->empty());
+		--m_size;
+		this->_destroy(m_data + m_size, m_data + m_size + 1);
+	}
+
+
+
+	//! Swaps the contents of this array and other.
+	void
+	swap(small_vector& other)
+	noexcept(std::is_nothrow_move_constructible_v<value_type>)
+	{
+		if (!this->_is_inline() && !other._is_inline()) {
+			mtk::_swap(m_data, other.m_data);
+			mtk::_swap(m_size, other.m_size);
+			mtk::_swap(m_capacity, other.m_capacity);
+			return;
+		}
+
+		small_vector tmp(mtk::_move(other));
+		other._take(*this);
+		this->_take(tmp);
+	}
+
+private:
+	static constexpr bool _is_trivially_relocatable = impl_core::growable_array::_is_trivially_relocatable<value_type>;
+
+	pointer
+	_inline_data() noexcept
+	{
+		return reinterpret_cast<pointer>(m_storage);
+	}
+
+	const_pointer
+	_inline_data() const noexcept
+	{
+		return reinterpret_cast<const_pointer>(m_storage);
+	}
+
+	bool
+	_is_inline() const noexcept
+	{
+		return (m_data == this->_inline_data());
+	}
+
+	size_type
+	_grown_capacity(size_type min_capacity) const noexcept
+	{
+		return mtk::_max(min_capacity, m_capacity*2);
+	}
+
+	static
+	void
+	_destroy(pointer first, pointer last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (; first != last; ++first)
+				first->~value_type();
+		} else {
+			MTK_IGNORE(first, last);
+		}
+	}
+
+	static
+	pointer
+	_allocate(size_type capacity)
+	{
+		if constexpr (_is_trivially_relocatable) {
+			void* ptr = std::malloc(capacity*sizeof(value_type));
+			if (!ptr)
+				throw std::bad_alloc();
+
+			return static_cast<pointer>(ptr);
+		} else {
+			return static_cast<pointer>(::operator new(capacity*sizeof(value_type), std::align_val_t(alignof(value_type))));
+		}
+	}
+
+	static
+	void
+	_deallocate(pointer ptr) noexcept
+	{
+		if constexpr (_is_trivially_relocatable)
+			std::free(ptr);
+		else
+			::operator delete(ptr, std::align_val_t(alignof(value_type)));
+	}
+
+	// Moves the size() elements at src to the uninitialized dst, src is left destroyed.
+	void
+	_relocate(pointer src, pointer dst)
+	{
+		if constexpr (_is_trivially_relocatable) {
+			mtk::_copy_range(src, src + m_size, dst);
+			return;
+		} else if constexpr (std::is_nothrow_move_constructible_v<value_type> || !std::is_copy_constructible_v<value_type>) {
+			for (size_type i = 0; i < m_size; ++i)
+				::new (static_cast<void*>(dst + i)) value_type(mtk::_move(src[i]));
+		} else {
+			size_type i = 0;
+			try {
+				for (; i < m_size; ++i)
+					::new (static_cast<void*>(dst + i)) value_type(static_cast<const value_type&>(src[i]));
+			} catch (...) {
+				this->_destroy(dst, dst + i);
+				throw;
+			}
+		}
+
+		this->_destroy(src, src + m_size);
+	}
+
+	// Moves the elements to storage for new_capacity elements, new_capacity >= size().
+	// Capacities up to N use the inline storage.
+	void
+	_reallocate(size_type new_capacity)
+	{
+		MTK_ASSERT(new_capacity >= m_size);
+
+		const pointer inline_data = this->_inline_data();
+		if (new_capacity <= N) {
+			if (m_data != inline_data) {
+				this->_relocate(m_data, inline_data);
+				this->_deallocate(m_data);
+				m_data = inline_data;
+				m_capacity = N;
+			}
+			return;
+		}
+
+		if constexpr (_is_trivially_relocatable) {
+			if (m_data != inline_data) {
+				void* ptr = std::realloc(m_data, new_capacity*sizeof(value_type));
+				if (!ptr)
+					throw std::bad_alloc();
+
+				m_data = static_cast<pointer>(ptr);
+				m_capacity = new_capacity;
+				return;
+			}
+		}
+
+		const pointer ptr = this->_allocate(new_capacity);
+		try {
+			this->_relocate(m_data, ptr);
+		} catch (...) {
+			this->_deallocate(ptr);
+			throw;
+		}
+
+		if (m_data != inline_data)
+			this->_deallocate(m_data);
+		m_data = ptr;
+		m_capacity = new_capacity;
+	}
+
+	// Moves the contents of other into *this, which must be empty and inline.
+	// other is left empty and inline.
+	void
+	_take(small_vector& other)
+	noexcept(std::is_nothrow_move_constructible_v<value_type>)
+	{
+		MTK_ASSERT(this->empty() && this->_is_inline());
+
+		if (!other._is_inline()) {
+			m_data = mtk::_exchange(other.m_data, other._inline_data());
+			m_size = mtk::_exchange(other.m_size, 0);
+			m_capacity = mtk::_exchange(other.m_capacity, N);
+			return;
+		}
+
+		for (; m_size < other.m_size; ++m_size)
+			::new (static_cast<void*>(m_data + m_size)) value_type(mtk::_move(other.m_data[m_size]));
+		other.clear();
+	}
+
+	template<class InputIter>
+	void
+	_append_range(InputIter first, InputIter last)
+	{
+		if constexpr (impl_core::array::_is_subtractable<InputIter>::value) {
+			MTK_ASSERT((last - first) >= 0);
+			const size_type count = size_type(last - first);
+			this->reserve(m_size + count);
+			if constexpr (_is_trivially_relocatable && impl_core::algorithm::_is_bulk_copyable<InputIter, pointer>) {
+				mtk::_copy_range(first, last, m_data + m_size);
+				m_size += count;
+				return;
+			}
+		}
+
+		while (first != last)
+			this->emplace_back(*(first++));
+	}
+
+	pointer m_data;
+	size_type m_size;
+	size_type m_capacity;
+	alignas(value_type) unsigned char m_storage[(N > 0 ? N : 1)*sizeof(value_type)];
+};
+
+//! @}
+
+//! @brief Swaps the contents of a and b.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N>
+void
+swap(small_vector<T, N>& a, small_vector<T, N>& b)
+noexcept(noexcept(a.swap(b)))
+{
+	a.swap(b);
+}
+
+//! @brief Returns true if the contents of lhs and rhs are equal, else false.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator==(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+
+	return mtk::_equal_range(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//! @brief Returns false if the contents of lhs and rhs are equal, else true.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator!=(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than rhs, else false.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator<(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	return mtk::_less_than_range(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than rhs, else false.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator>(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	return (rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than or equal to rhs, else false.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator<=(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than or equal to rhs, else false.
+//!
+//! @relates small_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+bool
+operator>=(const small_vector<T, N1>& lhs, const small_vector<T, N2>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,680 @@
+#ifndef MTK_CORE_STATIC_VECTOR_HPP
+#define MTK_CORE_STATIC_VECTOR_HPP
+
+//! @file
+//! Contains mtk::static_vector
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/preprocessor.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/algorithm.hpp>
+#include <mtk/core/impl/declval.hpp>
+#include <mtk/core/impl/move.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/core/impl/swap.hpp>
+
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace mtk {
+
+//! @addtogroup core
+//! @{
+
+namespace impl_core {
+namespace static_vector {
+
+[[noreturn]]
+void
+_throw_out_of_range_exception(size_t idx, size_t size);
+
+// Elements can live in a plain array and be assigned instead of constructed,
+// which keeps static_vector a literal type.
+template<class T>
+inline constexpr
+bool
+_is_literal_storage = std::is_trivially_default_constructible_v<T> &&
+	std::is_trivially_destructible_v<T> && std::is_trivially_copyable_v<T>;
+
+template<class T
+	,size_t N
+	,bool = _is_literal_storage<T>>
+struct _storage
+{
+	constexpr
+	_storage() noexcept :
+		m_data(),
+		m_size(0)
+	{ }
+
+	constexpr
+	T*
+	_data() noexcept
+	{
+		return m_data;
+	}
+
+	constexpr
+	const T*
+	_data() const noexcept
+	{
+		return m_data;
+	}
+
+	template<class... Args>
+	constexpr
+	void
+	_construct(size_t pos, Args&&... args)
+	{
+		m_data[pos] = T(mtk::_forward<Args>(args)...);
+	}
+
+	constexpr
+	void
+	_destroy(size_t first, size_t last) noexcept
+	{
+		MTK_IGNORE(first, last);
+	}
+
+	T m_data[N > 0 ? N : 1];
+	size_t m_size;
+};
+
+template<class T
+	,size_t N>
+struct _storage<T, N, false>
+{
+	_storage() noexcept :
+		m_size(0)
+	{ }
+
+	_storage(const _storage& other) :
+		m_size(0)
+	{
+		this->_append(other);
+	}
+
+	_storage(_storage&& other)
+	noexcept(std::is_nothrow_move_constructible_v<T>) :
+		m_size(0)
+	{
+		this->_append(mtk::_move(other));
+	}
+
+	~_storage()
+	{
+		this->_destroy(0, m_size);
+	}
+
+	_storage&
+	operator=(const _storage& other)
+	{
+		if (this != &other) {
+			this->_destroy(0, m_size);
+			m_size = 0;
+			this->_append(other);
+		}
+
+		return *this;
+	}
+
+	_storage&
+	operator=(_storage&& other)
+	noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other) {
+			this->_destroy(0, m_size);
+			m_size = 0;
+			this->_append(mtk::_move(other));
+		}
+
+		return *this;
+	}
+
+	T*
+	_data() noexcept
+	{
+		return reinterpret_cast<T*>(m_storage);
+	}
+
+	const T*
+	_data() const noexcept
+	{
+		return reinterpret_cast<const T*>(m_storage);
+	}
+
+	template<class... Args>
+	void
+	_construct(size_t pos, Args&&... args)
+	{
+		::new (static_cast<void*>(this->_data() + pos)) T(mtk::_forward<Args>(args)...);
+	}
+
+	void
+	_destroy(size_t first, size_t last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (T* it = this->_data() + first; it != this->_data() + last; ++it)
+				it->~T();
+		} else {
+			MTK_IGNORE(first, last);
+		}
+	}
+
+	// *this must be empty. Leaves *this empty if an element constructor throws.
+	template<class Storage>
+	void
+	_append(Storage&& other)
+	{
+		try {
+			for (; m_size < other.m_size; ++m_size) {
+				if constexpr (std::is_rvalue_reference_v<Storage&&>)
+					this->_construct(m_size, mtk::_move(other._data()[m_size]));
+				else
+					this->_construct(m_size, other._data()[m_size]);
+			}
+		} catch (...) {
+			this->_destroy(0, m_size);
+			m_size = 0;
+			throw;
+		}
+	}
+
+	alignas(T) unsigned char m_storage[(N > 0 ? N : 1)*sizeof(T)];
+	size_t m_size;
+};
+
+} // namespace static_vector
+} // namespace impl_core
+
+
+
+//! @brief Dynamic array with a fixed capacity of N elements stored inline, never allocates.
+//!
+//! @code
+//! #include <mtk/core/static_vector.hpp>
+//! @endcode
+//!
+//! Has the interface of mtk::growable_array, except that growing beyond N is a precondition violation.
+//!
+//! For trivially copyable, trivially default constructible types the elements live in a plain array,
+//! static_vector is then trivially copyable as well and usable in constant expressions.
+//! Other types are constructed in place in uninitialized storage.
+template<class T
+	,size_t N>
+class static_vector
+{
+public:
+	//! typedef.
+	using value_type = T;
+	//! typedef.
+	using size_type = size_t;
+	//! typedef.
+	using difference_type = ptrdiff_t;
+	//! typedef.
+	using reference = value_type&;
+	//! typedef.
+	using const_reference = const value_type&;
+	//! typedef.
+	using pointer = value_type*;
+	//! typedef.
+	using const_pointer = const value_type*;
+	//! typedef.
+	using iterator = pointer;
+	//! typedef.
+	using const_iterator = const_pointer;
+
+
+
+	//! Constructs an empty array.
+	constexpr
+	static_vector() noexcept = default;
+
+	//! @brief Constructs an array with size value initialized elements.
+	//!
+	//! @pre size <= N.
+	constexpr
+	explicit
+	static_vector(size_type size) :
+		static_vector()
+	{
+		this->resize(size);
+	}
+
+	//! @brief Constructs an array with size copies of value.
+	//!
+	//! @pre size <= N.
+	constexpr
+	static_vector(size_type size, const value_type& value) :
+		static_vector()
+	{
+		for (size_type i = 0; i < size; ++i)
+			this->push_back(value);
+	}
+
+	//! @brief Constructs an array initialized as a copy of the provided range.
+	//!
+	//! @pre ilist.size() <= N.
+	constexpr
+	static_vector(std::initializer_list<value_type> ilist) :
+		static_vector(ilist.begin(), ilist.end())
+	{ }
+
+	//! @brief Constructs an array initialized as a copy of the provided range.
+	//!
+	//! @pre The range holds at most N elements.
+	template<class InputIter
+#ifndef MTK_DOXYGEN
+		,_void_t<decltype(*mtk::_declval<InputIter>())>* = nullptr
+		,_void_t<decltype(*(mtk::_declval<InputIter&>()++))>* = nullptr
+#endif
+	>
+	constexpr
+	static_vector(InputIter first, InputIter last) :
+		static_vector()
+	{
+		while (first != last)
+			this->emplace_back(*(first++));
+	}
+
+
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	constexpr
+	reference
+	operator[](size_type pos)
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the element at position pos.
+	//!
+	//! @pre pos < size().
+	constexpr
+	const_reference
+	operator[](size_type pos) const
+	{
+		MTK_ASSERT(pos < this->size());
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	constexpr
+	reference
+	at(size_type pos)
+	{
+		if (pos >= this->size())
+			mtk::impl_core::static_vector::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! Returns the element at position pos. Throws std::out_of_range() if pos >= size().
+	constexpr
+	const_reference
+	at(size_type pos) const
+	{
+		if (pos >= this->size())
+			mtk::impl_core::static_vector::_throw_out_of_range_exception(pos, this->size());
+
+		return *(this->begin() + pos);
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	constexpr
+	reference
+	front()
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the first element.
+	//!
+	//! @pre empty() == false.
+	constexpr
+	const_reference
+	front() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *this->begin();
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	constexpr
+	reference
+	back()
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! @brief Returns the last element.
+	//!
+	//! @pre empty() == false.
+	constexpr
+	const_reference
+	back() const
+	{
+		MTK_ASSERT(!this->empty());
+		return *(this->end() - 1);
+	}
+
+	//! Returns a pointer to the first element in the array.
+	constexpr
+	pointer
+	data() noexcept
+	{
+		return m_storage._data();
+	}
+
+	//! Returns a pointer to the first element in the array.
+	constexpr
+	const_pointer
+	data() const noexcept
+	{
+		return m_storage._data();
+	}
+
+
+
+	//! Returns an iterator to the beginning of the array range.
+	constexpr
+	iterator
+	begin() noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	constexpr
+	const_iterator
+	begin() const noexcept
+	{
+		return this->data();
+	}
+
+	//! Returns an iterator to the beginning of the array range.
+	constexpr
+	const_iterator
+	cbegin() const noexcept
+	{
+		return this->begin();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	constexpr
+	iterator
+	end() noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	constexpr
+	const_iterator
+	end() const noexcept
+	{
+		return this->begin() + this->size();
+	}
+
+	//! Returns an iterator to the end of the array range.
+	constexpr
+	const_iterator
+	cend() const noexcept
+	{
+		return this->end();
+	}
+
+
+
+	//! Returns size() == 0.
+	[[nodiscard]]
+	constexpr
+	bool
+	empty() const noexcept
+	{
+		return (this->size() == 0);
+	}
+
+	//! Returns size() == capacity().
+	constexpr
+	bool
+	full() const noexcept
+	{
+		return (this->size() == N);
+	}
+
+	//! Returns the number of elements in the array.
+	constexpr
+	size_type
+	size() const noexcept
+	{
+		return m_storage.m_size;
+	}
+
+	//! Returns N.
+	static constexpr
+	size_type
+	capacity() noexcept
+	{
+		return N;
+	}
+
+	//! Returns N.
+	static constexpr
+	size_type
+	max_size() noexcept
+	{
+		return N;
+	}
+
+
+
+	//! Destroys all elements.
+	constexpr
+	void
+	clear() noexcept
+	{
+		m_storage._destroy(0, m_storage.m_size);
+		m_storage.m_size = 0;
+	}
+
+	//! @brief Resizes the current array to new_size.
+	//!
+	//! If new_size < size() then the excess elements are destroyed,
+	//! else if new_size > size() then value initialized elements are appended.
+	//!
+	//! @pre new_size <= N.
+	constexpr
+	void
+	resize(size_type new_size)
+	{
+		MTK_ASSERT(new_size <= N);
+
+		if (new_size <= m_storage.m_size) {
+			m_storage._destroy(new_size, m_storage.m_size);
+			m_storage.m_size = new_size;
+			return;
+		}
+
+		for (; m_storage.m_size < new_size; ++m_storage.m_size)
+			m_storage._construct(m_storage.m_size);
+	}
+
+	//! @brief Appends a copy of value.
+	//!
+	//! @pre full() == false.
+	constexpr
+	void
+	push_back(const value_type& value)
+	{
+		this->emplace_back(value);
+	}
+
+	//! @brief Appends value.
+	//!
+	//! @pre full() == false.
+	constexpr
+	void
+	push_back(value_type&& value)
+	{
+		this->emplace_back(mtk::_move(value));
+	}
+
+	//! @brief Appends an element constructed from args and returns it.
+	//!
+	//! @pre full() == false.
+	template<class... Args>
+	constexpr
+	reference
+	emplace_back(Args&&... args)
+	{
+		MTK_ASSERT(!this->full());
+
+		m_storage._construct(m_storage.m_size, mtk::_forward<Args>(args)...);
+		return this->data()[m_storage.m_size++];
+	}
+
+	//! @brief Destroys the last element.
+	//!
+	//! @pre empty() == false.
+	constexpr
+	void
+	pop_back()
+	{
+		MTK_ASSERT(!this->empty());
+		--m_storage.m_size;
+		m_storage._destroy(m_storage.m_size, m_storage.m_size + 1);
+	}
+
+
+
+	//! Swaps the contents of this array and other.
+	constexpr
+	void
+	swap(static_vector& other)
+	noexcept(std::is_nothrow_swappable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>)
+	{
+		static_vector& longer = (this->size() >= other.size() ? *this : other);
+		static_vector& shorter = (this->size() >= other.size() ? other : *this);
+
+		const size_type common = shorter.size();
+		mtk::_swap_range(shorter.begin(), shorter.end(), longer.begin());
+		for (size_type i = common; i < longer.size(); ++i)
+			shorter.emplace_back(mtk::_move(longer[i]));
+		longer.m_storage._destroy(common, longer.size());
+		longer.m_storage.m_size = common;
+	}
+
+private:
+	impl_core::static_vector::_storage<value_type, N> m_storage;
+};
+
+//! @}
+
+//! @brief Swaps the contents of a and b.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N>
+constexpr
+void
+swap(static_vector<T, N>& a, static_vector<T, N>& b)
+noexcept(noexcept(a.swap(b)))
+{
+	a.swap(b);
+}
+
+//! @brief Returns true if the contents of lhs and rhs are equal, else false.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator==(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+
+	return mtk::_equal_range(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+//! @brief Returns false if the contents of lhs and rhs are equal, else true.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator!=(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than rhs, else false.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator<(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	return mtk::_less_than_range(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than rhs, else false.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator>(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	return (rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically less than or equal to rhs, else false.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator<=(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+//! @brief Returns true if the elements of lhs is lexicographically greater than or equal to rhs, else false.
+//!
+//! @relates static_vector
+template<class T
+	,size_t N1
+	,size_t N2>
+constexpr
+bool
+operator>=(const static_vector<T, N1>& lhs, const static_vector<T, N2>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+} // namespace mtk
+
+#endif
@@ -400,6 +400,43 @@ make_unique(size_t n)
 	return unique_ptr<T>(new std::remove_extent_t<T>[n]());
 }
 
+//! @brief Default initializes an object of type T and wraps it in unique_ptr.
+//!
+//! Trivial types are left uninitialized, for storage that is about to be overwritten.
+//!
+//! @pre T must not be an array type.
+//!
+//! @relates unique_ptr
+template<class T
+#ifndef MTK_DOXYGEN
+	,_require<!std::is_array_v<T>> = 0
+#endif
+>
+unique_ptr<T>
+make_unique_for_overwrite()
+{
+	return unique_ptr<T>(new T);
+}
+
+//! @brief Default initializes an array of objects of type T and size n and wraps
+//! it in unique_ptr.
+//!
+//! Trivial types are left uninitialized, for storage that is about to be overwritten.
+//!
+//! @pre T must be an array type.
+//!
+//! @relates unique_ptr
+template<class T
+#ifndef MTK_DOXYGEN
+	,_require<std::is_array_v<T>> = 0
+#endif
+>
+unique_ptr<T>
+make_unique_for_overwrite(size_t n)
+{
+	return unique_ptr<T>(new std::remove_extent_t<T>[n]);
+}
+
 //! @}
 
 //! @brief Swaps the contained pointers.
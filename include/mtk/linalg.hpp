@@ -1,7 +1,23 @@
 #ifndef MTK_LINALG_HPP
 #define MTK_LINALG_HPP
 
+#include <mtk/linalg/affine.hpp>
+#include <mtk/linalg/banded.hpp>
+#include <mtk/linalg/batch.hpp>
+#include <mtk/linalg/convolve.hpp>
+#include <mtk/linalg/decomposition.hpp>
+#include <mtk/linalg/diagonal.hpp>
+#include <mtk/linalg/exponential.hpp>
+#include <mtk/linalg/fft.hpp>
 #include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/gemm.hpp>
+#include <mtk/linalg/least_squares.hpp>
 #include <mtk/linalg/matrix.hpp>
+#include <mtk/linalg/quantize.hpp>
+#include <mtk/linalg/quaternion.hpp>
+#include <mtk/linalg/strassen.hpp>
+#include <mtk/linalg/symmetric.hpp>
+#include <mtk/linalg/tensor.hpp>
+#include <mtk/linalg/triangular.hpp>
 
 #endif
@@ -0,0 +1,252 @@
+#ifndef MTK_LINALG_AFFINE_HPP
+#define MTK_LINALG_AFFINE_HPP
+
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+#include <mtk/linalg/quaternion.hpp>
+
+#include <optional>
+#include <type_traits>
+
+namespace mtk {
+
+template<class T>
+class affine3
+{
+public:
+	static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
+
+	using value_type = T;
+	using size_type = size_t;
+	using storage_type = matrix<T, 3, 4>;
+
+	constexpr
+	affine3() :
+		m_data()
+	{ }
+
+	constexpr
+	affine3(const matrix<T, 3, 3>& linear, const vector<T, 3>& translation) :
+		m_data()
+	{
+		for (size_t row = 0; row < 3; ++row) {
+			for (size_t col = 0; col < 3; ++col)
+				m_data.value(row, col) = linear.value(row, col);
+
+			m_data.value(row, 3) = translation.value(row);
+		}
+	}
+
+	constexpr
+	affine3(const quaternion<T>& rotation, const vector<T, 3>& translation) :
+		affine3(rotation.to_matrix3(), translation)
+	{ }
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<(Mat::row_dimension == 3) || (Mat::row_dimension == 4)> = 0
+		,_require<(Mat::column_dimension == 4)> = 0
+#endif
+	>
+	explicit constexpr
+	affine3(const _matrix_base<Mat>& m) :
+		m_data()
+	{
+		for (size_t row = 0; row < 3; ++row) {
+			for (size_t col = 0; col < 4; ++col)
+				m_data.value(row, col) = static_cast<T>(m.value(row, col));
+		}
+	}
+
+	static constexpr
+	affine3
+	identity()
+	{
+		affine3 ret;
+		ret.m_data.value(0, 0) = T(1);
+		ret.m_data.value(1, 1) = T(1);
+		ret.m_data.value(2, 2) = T(1);
+		return ret;
+	}
+
+	constexpr
+	T&
+	value(size_type row, size_type col)
+	{
+		return m_data.value(row, col);
+	}
+
+	constexpr
+	const T&
+	value(size_type row, size_type col) const
+	{
+		return m_data.value(row, col);
+	}
+
+	constexpr
+	const storage_type&
+	storage() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr
+	matrix<T, 3, 3>
+	linear() const
+	{
+		return matrix<T, 3, 3>(
+			m_data.value(0, 0), m_data.value(0, 1), m_data.value(0, 2),
+			m_data.value(1, 0), m_data.value(1, 1), m_data.value(1, 2),
+			m_data.value(2, 0), m_data.value(2, 1), m_data.value(2, 2));
+	}
+
+	constexpr
+	vector<T, 3>
+	translation() const
+	{
+		return vector<T, 3>(m_data.value(0, 3), m_data.value(1, 3), m_data.value(2, 3));
+	}
+
+	constexpr
+	matrix<T, 4, 4>
+	to_matrix4() const
+	{
+		matrix<T, 4, 4> ret;
+		for (size_t row = 0; row < 3; ++row) {
+			for (size_t col = 0; col < 4; ++col)
+				ret.value(row, col) = m_data.value(row, col);
+		}
+		ret.value(3, 3) = T(1);
+		return ret;
+	}
+
+	constexpr
+	vector<T, 3>
+	transform_point(const vector<T, 3>& point) const
+	{
+		const T x = point.value(0);
+		const T y = point.value(1);
+		const T z = point.value(2);
+		return vector<T, 3>(
+			m_data.value(0, 0)*x + m_data.value(0, 1)*y + m_data.value(0, 2)*z + m_data.value(0, 3),
+			m_data.value(1, 0)*x + m_data.value(1, 1)*y + m_data.value(1, 2)*z + m_data.value(1, 3),
+			m_data.value(2, 0)*x + m_data.value(2, 1)*y + m_data.value(2, 2)*z + m_data.value(2, 3));
+	}
+
+	constexpr
+	vector<T, 3>
+	transform_vector(const vector<T, 3>& vec) const
+	{
+		const T x = vec.value(0);
+		const T y = vec.value(1);
+		const T z = vec.value(2);
+		return vector<T, 3>(
+			m_data.value(0, 0)*x + m_data.value(0, 1)*y + m_data.value(0, 2)*z,
+			m_data.value(1, 0)*x + m_data.value(1, 1)*y + m_data.value(1, 2)*z,
+			m_data.value(2, 0)*x + m_data.value(2, 1)*y + m_data.value(2, 2)*z);
+	}
+
+	constexpr
+	std::optional<affine3>
+	inverted() const
+	{
+		const auto lin_inv = this->linear().inverted();
+		if (!lin_inv)
+			return std::optional<affine3>();
+
+		return std::optional<affine3>(affine3::_from_inverse_linear(*lin_inv, this->translation()));
+	}
+
+	// Only valid when the linear part is orthonormal, its inverse is then its transpose.
+	constexpr
+	affine3
+	rigid_inverted() const
+	{
+		return affine3::_from_inverse_linear(this->linear().transposed(), this->translation());
+	}
+
+	constexpr
+	void
+	invert()
+	{
+		auto inv = this->inverted();
+		if (inv)
+			*this = *inv;
+		else
+			*this = affine3::identity();
+	}
+
+	constexpr
+	void
+	rigid_invert()
+	{
+		*this = this->rigid_inverted();
+	}
+
+	constexpr
+	affine3&
+	operator*=(const affine3& rhs)
+	{
+		affine3 ret;
+		for (size_t row = 0; row < 3; ++row) {
+			for (size_t col = 0; col < 4; ++col) {
+				T sum = (col == 3 ? m_data.value(row, 3) : T());
+				for (size_t i = 0; i < 3; ++i)
+					sum += m_data.value(row, i)*rhs.m_data.value(i, col);
+
+				ret.m_data.value(row, col) = sum;
+			}
+		}
+
+		return *this = ret;
+	}
+
+private:
+	static constexpr
+	affine3
+	_from_inverse_linear(const matrix<T, 3, 3>& lin_inv, const vector<T, 3>& translation)
+	{
+		return affine3(lin_inv, -(lin_inv*translation));
+	}
+
+	storage_type m_data;
+};
+
+
+
+template<class T>
+constexpr
+bool
+operator==(const affine3<T>& lhs, const affine3<T>& rhs)
+{
+	for (size_t row = 0; row < 3; ++row) {
+		for (size_t col = 0; col < 4; ++col) {
+			if (lhs.value(row, col) != rhs.value(row, col))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template<class T>
+constexpr
+bool
+operator!=(const affine3<T>& lhs, const affine3<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template<class T>
+constexpr
+affine3<T>
+operator*(affine3<T> lhs, const affine3<T>& rhs)
+{
+	return lhs *= rhs;
+}
+
+} // namespace mtk
+
+#endif
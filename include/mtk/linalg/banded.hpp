@@ -0,0 +1,298 @@
+#ifndef MTK_LINALG_BANDED_HPP
+#define MTK_LINALG_BANDED_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <optional>
+#include <type_traits>
+
+namespace mtk {
+
+// Thomas algorithm, rhs is overwritten with the solution.
+// Fails on a zero pivot, it does not pivot and is only stable
+// for diagonally dominant or symmetric positive definite systems.
+template<class S>
+bool
+solve_tridiagonal(span<const S> lower, span<const S> diag, span<const S> upper, span<S> rhs)
+{
+	const size_t size = diag.size();
+	MTK_ASSERT(rhs.size() == size);
+	MTK_ASSERT((size == 0) || (lower.size() + 1 == size));
+	MTK_ASSERT((size == 0) || (upper.size() + 1 == size));
+
+	if (size == 0)
+		return true;
+
+	array<S> upper_prime(size);
+	S denom = diag[0];
+	if (denom == S())
+		return false;
+
+	rhs[0] /= denom;
+	for (size_t i = 1; i < size; ++i) {
+		upper_prime[i - 1] = upper[i - 1] / denom;
+		denom = diag[i] - lower[i - 1]*upper_prime[i - 1];
+		if (denom == S())
+			return false;
+
+		rhs[i] = (rhs[i] - lower[i - 1]*rhs[i - 1]) / denom;
+	}
+
+	for (size_t i = size - 1; i > 0; --i)
+		rhs[i - 1] -= upper_prime[i - 1]*rhs[i];
+
+	return true;
+}
+
+
+
+// Row i stores columns [i - lower, i + upper] contiguously,
+// out of range slots at the top left and bottom right corners are unused.
+template<class Scalar>
+class banded_matrix
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+
+	static constexpr
+	size_type
+	row_dimension = dynamic_extent;
+
+	static constexpr
+	size_type
+	column_dimension = dynamic_extent;
+
+	banded_matrix() :
+		m_data(),
+		m_size(),
+		m_lower(),
+		m_upper()
+	{ }
+
+	banded_matrix(size_type size, size_type lower, size_type upper) :
+		m_data(size*(lower + upper + 1)),
+		m_size(size),
+		m_lower(lower),
+		m_upper(upper)
+	{ }
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+#endif
+	>
+	banded_matrix(const _matrix_base<Mat>& m, size_type lower, size_type upper) :
+		banded_matrix(m.rows(), lower, upper)
+	{
+		MTK_ASSERT(m.rows() == m.columns());
+
+		for (size_type row = 0; row < m_size; ++row) {
+			const size_type first = this->_first_column(row);
+			const size_type last = this->_last_column(row);
+			for (size_type col = first; col < last; ++col)
+				m_data[this->_index(row, col)] = m.value(row, col);
+		}
+	}
+
+	size_type
+	rows() const
+	{
+		return m_size;
+	}
+
+	size_type
+	columns() const
+	{
+		return m_size;
+	}
+
+	size_type
+	lower_bandwidth() const
+	{
+		return m_lower;
+	}
+
+	size_type
+	upper_bandwidth() const
+	{
+		return m_upper;
+	}
+
+	bool
+	in_band(size_type row, size_type col) const
+	{
+		return ((col + m_lower >= row) && (col <= row + m_upper));
+	}
+
+	value_type&
+	value(size_type row, size_type col)
+	{
+		MTK_ASSERT(this->in_band(row, col));
+		return m_data[this->_index(row, col)];
+	}
+
+	value_type
+	value(size_type row, size_type col) const
+	{
+		return (this->in_band(row, col) ? m_data[this->_index(row, col)] : value_type());
+	}
+
+	auto
+	to_dense() const
+	{
+		matrix<value_type, dynamic_extent, dynamic_extent> ret(m_size, m_size);
+		for (size_type row = 0; row < m_size; ++row) {
+			const size_type first = this->_first_column(row);
+			const size_type last = this->_last_column(row);
+			for (size_type col = first; col < last; ++col)
+				ret.value(row, col) = m_data[this->_index(row, col)];
+		}
+
+		return ret;
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, value_type>> = 0
+#endif
+	>
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		MTK_ASSERT(rhs.rows() == m_size);
+
+		using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, Other::row_dimension, Other::column_dimension, Other::options>;
+
+		ret_type ret(rhs);
+		const size_type cols = ret.columns();
+		if ((m_lower == 1) && (m_upper == 1) && (m_size > 0)) {
+			array<value_type> lower(m_size - 1);
+			array<value_type> diag(m_size);
+			array<value_type> upper(m_size - 1);
+			array<value_type> x(m_size);
+			for (size_type i = 0; i < m_size; ++i) {
+				diag[i] = m_data[this->_index(i, i)];
+				if (i > 0)
+					lower[i - 1] = m_data[this->_index(i, i - 1)];
+				if (i + 1 < m_size)
+					upper[i] = m_data[this->_index(i, i + 1)];
+			}
+
+			for (size_type col = 0; col < cols; ++col) {
+				for (size_type i = 0; i < m_size; ++i)
+					x[i] = ret.value(i, col);
+
+				if (!mtk::solve_tridiagonal<value_type>(lower, diag, upper, x))
+					return std::optional<ret_type>();
+
+				for (size_type i = 0; i < m_size; ++i)
+					ret.value(i, col) = x[i];
+			}
+
+			return std::optional<ret_type>(mtk::_move(ret));
+		}
+
+		// Gaussian elimination without pivoting keeps the factors inside the band.
+		array<value_type> lu(m_data.begin(), m_data.end());
+		for (size_type k = 0; k < m_size; ++k) {
+			const value_type pivot = lu[this->_index(k, k)];
+			if (pivot == value_type())
+				return std::optional<ret_type>();
+
+			const size_type row_last = mtk::_min(m_size, k + m_lower + 1);
+			const size_type col_last = mtk::_min(m_size, k + m_upper + 1);
+			for (size_type row = k + 1; row < row_last; ++row) {
+				const value_type factor = lu[this->_index(row, k)] / pivot;
+				for (size_type col = k + 1; col < col_last; ++col)
+					lu[this->_index(row, col)] -= factor*lu[this->_index(k, col)];
+				for (size_type col = 0; col < cols; ++col)
+					ret.value(row, col) -= factor*ret.value(k, col);
+			}
+		}
+
+		for (size_type n = 0; n < m_size; ++n) {
+			const size_type row = m_size - 1 - n;
+			const size_type last = this->_last_column(row);
+			for (size_type k = row + 1; k < last; ++k) {
+				const value_type factor = lu[this->_index(row, k)];
+				for (size_type col = 0; col < cols; ++col)
+					ret.value(row, col) -= factor*ret.value(k, col);
+			}
+
+			const value_type diag = lu[this->_index(row, row)];
+			for (size_type col = 0; col < cols; ++col)
+				ret.value(row, col) /= diag;
+		}
+
+		return std::optional<ret_type>(mtk::_move(ret));
+	}
+
+	size_type
+	_first_column(size_type row) const
+	{
+		return (row > m_lower ? row - m_lower : 0);
+	}
+
+	size_type
+	_last_column(size_type row) const
+	{
+		return mtk::_min(m_size, row + m_upper + 1);
+	}
+
+	size_type
+	_index(size_type row, size_type col) const
+	{
+		return row*(m_lower + m_upper + 1) + (col + m_lower - row);
+	}
+
+private:
+	array<value_type> m_data;
+	size_type m_size;
+	size_type m_lower;
+	size_type m_upper;
+};
+
+
+
+template<class Scalar
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<Scalar, typename Mat::value_type>> = 0
+#endif
+>
+auto
+operator*(const banded_matrix<Scalar>& lhs, const _matrix_base<Mat>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Scalar, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	const size_t size = lhs.rows();
+	const size_t cols = rhs.columns();
+	auto ret = mtk::_make_matrix<ret_type>(size, cols);
+	for (size_t row = 0; row < size; ++row) {
+		const size_t first = lhs._first_column(row);
+		const size_t last = lhs._last_column(row);
+		for (size_t col = 0; col < cols; ++col) {
+			Scalar sum = Scalar();
+			for (size_t k = first; k < last; ++k)
+				sum += lhs.value(row, k)*rhs.value(k, col);
+
+			ret.value(row, col) = sum;
+		}
+	}
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
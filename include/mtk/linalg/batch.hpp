@@ -0,0 +1,201 @@
+#ifndef MTK_LINALG_BATCH_HPP
+#define MTK_LINALG_BATCH_HPP
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <limits>
+#include <type_traits>
+
+namespace mtk {
+namespace impl_batch {
+
+// Matrices are transposed into structure of arrays lane groups so the
+// cofactor expressions below compile to straight line SIMD code.
+template<class S>
+inline constexpr
+size_t
+_lanes = 64 / sizeof(S);
+
+template<class S>
+using _lane_group = S[16][_lanes<S>];
+
+template<class S
+	,matrix_options Opt>
+void
+_load(const matrix<S, 4, 4, Opt>* src, size_t count, _lane_group<S>& m)
+{
+	for (size_t l = 0; l < count; ++l) {
+		for (size_t row = 0; row < 4; ++row) {
+			for (size_t col = 0; col < 4; ++col)
+				m[row*4 + col][l] = src[l].value(row, col);
+		}
+	}
+
+	for (size_t l = count; l < _lanes<S>; ++l) {
+		for (size_t i = 0; i < 16; ++i)
+			m[i][l] = S();
+	}
+}
+
+template<class S
+	,matrix_options Opt>
+void
+_store(const _lane_group<S>& m, size_t count, matrix<S, 4, 4, Opt>* dst)
+{
+	for (size_t l = 0; l < count; ++l) {
+		for (size_t row = 0; row < 4; ++row) {
+			for (size_t col = 0; col < 4; ++col)
+				dst[l].value(row, col) = m[row*4 + col][l];
+		}
+	}
+}
+
+template<class S>
+void
+_determinant(const _lane_group<S>& m, S (&det)[_lanes<S>])
+{
+	for (size_t l = 0; l < _lanes<S>; ++l) {
+		const auto v = [&](size_t row, size_t col) { return m[row*4 + col][l]; };
+		const S s0 = v(0, 0)*v(1, 1) - v(1, 0)*v(0, 1);
+		const S s1 = v(0, 0)*v(1, 2) - v(1, 0)*v(0, 2);
+		const S s2 = v(0, 0)*v(1, 3) - v(1, 0)*v(0, 3);
+		const S s3 = v(0, 1)*v(1, 2) - v(1, 1)*v(0, 2);
+		const S s4 = v(0, 1)*v(1, 3) - v(1, 1)*v(0, 3);
+		const S s5 = v(0, 2)*v(1, 3) - v(1, 2)*v(0, 3);
+		const S c0 = v(2, 0)*v(3, 1) - v(3, 0)*v(2, 1);
+		const S c1 = v(2, 0)*v(3, 2) - v(3, 0)*v(2, 2);
+		const S c2 = v(2, 0)*v(3, 3) - v(3, 0)*v(2, 3);
+		const S c3 = v(2, 1)*v(3, 2) - v(3, 1)*v(2, 2);
+		const S c4 = v(2, 1)*v(3, 3) - v(3, 1)*v(2, 3);
+		const S c5 = v(2, 2)*v(3, 3) - v(3, 2)*v(2, 3);
+		det[l] = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+	}
+}
+
+// Singular lanes are written as the identity, matching _matrix_detinv_fp_base::invert.
+template<class S>
+void
+_invert(const _lane_group<S>& m, _lane_group<S>& ret, bool (&ok)[_lanes<S>])
+{
+	for (size_t l = 0; l < _lanes<S>; ++l) {
+		const auto v = [&](size_t row, size_t col) { return m[row*4 + col][l]; };
+		const S s0 = v(0, 0)*v(1, 1) - v(1, 0)*v(0, 1);
+		const S s1 = v(0, 0)*v(1, 2) - v(1, 0)*v(0, 2);
+		const S s2 = v(0, 0)*v(1, 3) - v(1, 0)*v(0, 3);
+		const S s3 = v(0, 1)*v(1, 2) - v(1, 1)*v(0, 2);
+		const S s4 = v(0, 1)*v(1, 3) - v(1, 1)*v(0, 3);
+		const S s5 = v(0, 2)*v(1, 3) - v(1, 2)*v(0, 3);
+		const S c0 = v(2, 0)*v(3, 1) - v(3, 0)*v(2, 1);
+		const S c1 = v(2, 0)*v(3, 2) - v(3, 0)*v(2, 2);
+		const S c2 = v(2, 0)*v(3, 3) - v(3, 0)*v(2, 3);
+		const S c3 = v(2, 1)*v(3, 2) - v(3, 1)*v(2, 2);
+		const S c4 = v(2, 1)*v(3, 3) - v(3, 1)*v(2, 3);
+		const S c5 = v(2, 2)*v(3, 3) - v(3, 2)*v(2, 3);
+
+		const S det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+		const S pos_det = (det < S() ? -det : det);
+		const bool invertible = (pos_det > std::numeric_limits<S>::epsilon());
+		const S det_inv = (invertible ? S(1) / det : S());
+		const S diag = (invertible ? S() : S(1));
+
+		const S m11 = ( v(1, 1)*c5 - v(1, 2)*c4 + v(1, 3)*c3)*det_inv + diag;
+		const S m12 = (-v(0, 1)*c5 + v(0, 2)*c4 - v(0, 3)*c3)*det_inv;
+		const S m13 = ( v(3, 1)*s5 - v(3, 2)*s4 + v(3, 3)*s3)*det_inv;
+		const S m14 = (-v(2, 1)*s5 + v(2, 2)*s4 - v(2, 3)*s3)*det_inv;
+		const S m21 = (-v(1, 0)*c5 + v(1, 2)*c2 - v(1, 3)*c1)*det_inv;
+		const S m22 = ( v(0, 0)*c5 - v(0, 2)*c2 + v(0, 3)*c1)*det_inv + diag;
+		const S m23 = (-v(3, 0)*s5 + v(3, 2)*s2 - v(3, 3)*s1)*det_inv;
+		const S m24 = ( v(2, 0)*s5 - v(2, 2)*s2 + v(2, 3)*s1)*det_inv;
+		const S m31 = ( v(1, 0)*c4 - v(1, 1)*c2 + v(1, 3)*c0)*det_inv;
+		const S m32 = (-v(0, 0)*c4 + v(0, 1)*c2 - v(0, 3)*c0)*det_inv;
+		const S m33 = ( v(3, 0)*s4 - v(3, 1)*s2 + v(3, 3)*s0)*det_inv + diag;
+		const S m34 = (-v(2, 0)*s4 + v(2, 1)*s2 - v(2, 3)*s0)*det_inv;
+		const S m41 = (-v(1, 0)*c3 + v(1, 1)*c1 - v(1, 2)*c0)*det_inv;
+		const S m42 = ( v(0, 0)*c3 - v(0, 1)*c1 + v(0, 2)*c0)*det_inv;
+		const S m43 = (-v(3, 0)*s3 + v(3, 1)*s1 - v(3, 2)*s0)*det_inv;
+		const S m44 = ( v(2, 0)*s3 - v(2, 1)*s1 + v(2, 2)*s0)*det_inv + diag;
+
+		ret[0][l] = m11;
+		ret[1][l] = m12;
+		ret[2][l] = m13;
+		ret[3][l] = m14;
+		ret[4][l] = m21;
+		ret[5][l] = m22;
+		ret[6][l] = m23;
+		ret[7][l] = m24;
+		ret[8][l] = m31;
+		ret[9][l] = m32;
+		ret[10][l] = m33;
+		ret[11][l] = m34;
+		ret[12][l] = m41;
+		ret[13][l] = m42;
+		ret[14][l] = m43;
+		ret[15][l] = m44;
+		ok[l] = invertible;
+	}
+}
+
+} // namespace impl_batch
+
+
+
+template<class S
+	,matrix_options Opt
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<S>> = 0
+#endif
+>
+void
+determinant(span<const matrix<S, 4, 4, Opt>> src, span<S> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+
+	constexpr size_t lanes = impl_batch::_lanes<S>;
+	impl_batch::_lane_group<S> m;
+	S det[lanes];
+	const size_t size = src.size();
+	for (size_t first = 0; first < size; first += lanes) {
+		const size_t count = mtk::_min(lanes, size - first);
+		impl_batch::_load(src.data() + first, count, m);
+		impl_batch::_determinant(m, det);
+		for (size_t l = 0; l < count; ++l)
+			dst[first + l] = det[l];
+	}
+}
+
+template<class S
+	,matrix_options Opt
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<S>> = 0
+#endif
+>
+void
+invert(span<const matrix<S, 4, 4, Opt>> src, span<matrix<S, 4, 4, Opt>> dst, span<bool> ok)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	MTK_ASSERT(src.size() == ok.size());
+
+	constexpr size_t lanes = impl_batch::_lanes<S>;
+	impl_batch::_lane_group<S> m;
+	impl_batch::_lane_group<S> inv;
+	bool lane_ok[lanes];
+	const size_t size = src.size();
+	for (size_t first = 0; first < size; first += lanes) {
+		const size_t count = mtk::_min(lanes, size - first);
+		impl_batch::_load(src.data() + first, count, m);
+		impl_batch::_invert(m, inv, lane_ok);
+		impl_batch::_store(inv, count, dst.data() + first);
+		for (size_t l = 0; l < count; ++l)
+			ok[first + l] = lane_ok[l];
+	}
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef MTK_LINALG_CONVOLVE_HPP
+#define MTK_LINALG_CONVOLVE_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/parallel.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <limits>
+#include <type_traits>
+
+namespace mtk {
+
+// valid only keeps outputs where the kernel fits entirely inside the input,
+// all other modes produce an output the size of the input.
+// reflect mirrors around the edge element without repeating it.
+enum class border_mode
+{
+	valid,
+	zero,
+	replicate,
+	reflect,
+	wrap
+};
+
+
+
+namespace impl_convolve {
+
+// Multiply-adds per parallel task, below this the whole image runs on the calling thread.
+inline constexpr
+size_t
+_parallel_grain = size_t(1) << 18;
+
+// Output rows per separable pass, the intermediate strip stays cache resident.
+inline constexpr
+size_t
+_strip_rows = 32;
+
+void
+_axpy(float a, const float* x, float* y, size_t n);
+
+template<class T>
+void
+_axpy(T a, const T* x, T* y, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		y[i] += a*x[i];
+}
+
+inline
+ptrdiff_t
+_border_index(ptrdiff_t idx, ptrdiff_t size, border_mode border)
+{
+	if ((idx >= 0) && (idx < size))
+		return idx;
+
+	switch (border) {
+	case border_mode::replicate:
+		return (idx < 0 ? 0 : size - 1);
+	case border_mode::reflect: {
+		if (size == 1)
+			return 0;
+
+		const ptrdiff_t period = 2*size - 2;
+		idx %= period;
+		if (idx < 0)
+			idx += period;
+		return (idx < size ? idx : period - idx);
+	}
+	case border_mode::wrap:
+		idx %= size;
+		return (idx < 0 ? idx + size : idx);
+	default:
+		return -1;
+	}
+}
+
+template<class Mat>
+array<typename Mat::value_type>
+_pad(const _matrix_base<Mat>& m, size_t kernel_rows, size_t kernel_cols, border_mode border)
+{
+	using value_type = typename Mat::value_type;
+
+	const size_t rows = m.rows();
+	const size_t cols = m.columns();
+	const bool valid = (border == border_mode::valid);
+	const size_t padded_rows = (valid ? rows : rows + kernel_rows - 1);
+	const size_t padded_cols = (valid ? cols : cols + kernel_cols - 1);
+	const ptrdiff_t top = (valid ? 0 : ptrdiff_t(kernel_rows / 2));
+	const ptrdiff_t left = (valid ? 0 : ptrdiff_t(kernel_cols / 2));
+
+	array<ptrdiff_t> col_map(padded_cols);
+	for (size_t col = 0; col < padded_cols; ++col)
+		col_map[col] = impl_convolve::_border_index(ptrdiff_t(col) - left, ptrdiff_t(cols), border);
+
+	array<value_type> ret(padded_rows*padded_cols);
+	for (size_t row = 0; row < padded_rows; ++row) {
+		const ptrdiff_t src_row = impl_convolve::_border_index(ptrdiff_t(row) - top, ptrdiff_t(rows), border);
+		if (src_row < 0)
+			continue;
+
+		value_type* dst = ret.data() + row*padded_cols;
+		for (size_t col = 0; col < size_t(left); ++col) {
+			if (col_map[col] >= 0)
+				dst[col] = m.value(size_t(src_row), size_t(col_map[col]));
+		}
+
+		for (size_t col = 0; col < cols; ++col)
+			dst[size_t(left) + col] = m.value(size_t(src_row), col);
+
+		for (size_t col = size_t(left) + cols; col < padded_cols; ++col) {
+			if (col_map[col] >= 0)
+				dst[col] = m.value(size_t(src_row), size_t(col_map[col]));
+		}
+	}
+
+	return ret;
+}
+
+// Splits a rank one kernel into a column and a row factor, k(i, j) == col[i]*row[j].
+template<class T>
+bool
+_separate(const T* kernel, size_t rows, size_t cols, T* col, T* row)
+{
+	if constexpr (!std::is_floating_point_v<T>) {
+		return false;
+	} else {
+		size_t pivot = 0;
+		T pivot_abs = T();
+		for (size_t i = 0; i < rows*cols; ++i) {
+			const T val = (kernel[i] < T() ? -kernel[i] : kernel[i]);
+			if (val > pivot_abs) {
+				pivot = i;
+				pivot_abs = val;
+			}
+		}
+
+		if (pivot_abs == T())
+			return false;
+
+		const size_t pivot_row = pivot / cols;
+		const size_t pivot_col = pivot % cols;
+		for (size_t i = 0; i < rows; ++i)
+			col[i] = kernel[i*cols + pivot_col];
+		for (size_t j = 0; j < cols; ++j)
+			row[j] = kernel[pivot_row*cols + j] / kernel[pivot];
+
+		const T tolerance = 64*std::numeric_limits<T>::epsilon()*pivot_abs;
+		for (size_t i = 0; i < rows; ++i) {
+			for (size_t j = 0; j < cols; ++j) {
+				const T diff = kernel[i*cols + j] - col[i]*row[j];
+				if ((diff > tolerance) || (-diff > tolerance))
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+template<class Mat>
+auto
+_correlate(const _matrix_base<Mat>& m, const typename Mat::value_type* kernel, size_t kernel_rows, size_t kernel_cols, border_mode border)
+{
+	using value_type = typename Mat::value_type;
+	using ret_type = matrix<value_type, dynamic_extent, dynamic_extent>;
+
+	MTK_ASSERT((kernel_rows > 0) && (kernel_cols > 0));
+
+	const bool valid = (border == border_mode::valid);
+	const size_t rows = m.rows();
+	const size_t cols = m.columns();
+	const size_t out_rows = (valid ? (rows >= kernel_rows ? rows - kernel_rows + 1 : 0) : rows);
+	const size_t out_cols = (valid ? (cols >= kernel_cols ? cols - kernel_cols + 1 : 0) : cols);
+	ret_type ret(out_rows, out_cols);
+	if (ret.empty())
+		return ret;
+
+	const array<value_type> padded = impl_convolve::_pad(m, kernel_rows, kernel_cols, border);
+	const size_t padded_cols = (valid ? cols : cols + kernel_cols - 1);
+	const value_type* src = padded.data();
+	value_type* dst = ret.data();
+
+	array<value_type> col_factor(kernel_rows);
+	array<value_type> row_factor(kernel_cols);
+	if ((kernel_rows > 1) && (kernel_cols > 1) && impl_convolve::_separate(kernel, kernel_rows, kernel_cols, col_factor.data(), row_factor.data())) {
+		const size_t grain = mtk::_max(_parallel_grain / (out_cols*(kernel_rows + kernel_cols)), size_t(1));
+		mtk::_parallel_for(out_rows, grain, [&](size_t first, size_t last) {
+			array<value_type> strip((_strip_rows + kernel_rows - 1)*out_cols);
+			for (size_t strip_first = first; strip_first < last; strip_first += _strip_rows) {
+				const size_t strip_rows = mtk::_min(_strip_rows, last - strip_first);
+				const size_t strip_src_rows = strip_rows + kernel_rows - 1;
+				for (size_t i = 0; i < strip_src_rows*out_cols; ++i)
+					strip[i] = value_type();
+
+				for (size_t row = 0; row < strip_src_rows; ++row) {
+					const value_type* src_row = src + (strip_first + row)*padded_cols;
+					for (size_t j = 0; j < kernel_cols; ++j)
+						impl_convolve::_axpy(row_factor[j], src_row + j, strip.data() + row*out_cols, out_cols);
+				}
+
+				for (size_t row = 0; row < strip_rows; ++row) {
+					for (size_t i = 0; i < kernel_rows; ++i)
+						impl_convolve::_axpy(col_factor[i], strip.data() + (row + i)*out_cols, dst + (strip_first + row)*out_cols, out_cols);
+				}
+			}
+		});
+
+		return ret;
+	}
+
+	const size_t grain = mtk::_max(_parallel_grain / (out_cols*kernel_rows*kernel_cols), size_t(1));
+	mtk::_parallel_for(out_rows, grain, [&](size_t first, size_t last) {
+		for (size_t row = first; row < last; ++row) {
+			for (size_t i = 0; i < kernel_rows; ++i) {
+				const value_type* src_row = src + (row + i)*padded_cols;
+				for (size_t j = 0; j < kernel_cols; ++j)
+					impl_convolve::_axpy(kernel[i*kernel_cols + j], src_row + j, dst + row*out_cols, out_cols);
+			}
+		}
+	});
+
+	return ret;
+}
+
+template<class Mat
+	,class T>
+void
+_load_kernel(const _matrix_base<Mat>& kernel, T* dst, bool flip)
+{
+	const size_t rows = kernel.rows();
+	const size_t cols = kernel.columns();
+	for (size_t row = 0; row < rows; ++row) {
+		for (size_t col = 0; col < cols; ++col) {
+			const size_t idx = (flip ? (rows - 1 - row)*cols + (cols - 1 - col) : row*cols + col);
+			dst[idx] = kernel.value(row, col);
+		}
+	}
+}
+
+} // namespace impl_convolve
+
+
+
+// out(r, c) = sum of kernel(i, j)*m(r + i - kernel.rows()/2, c + j - kernel.columns()/2),
+// with valid dropping the offsets and only producing fully covered outputs.
+template<class Mat
+	,class Kernel
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename Mat::value_type, typename Kernel::value_type>> = 0
+#endif
+>
+auto
+correlate2d(const _matrix_base<Mat>& m, const _matrix_base<Kernel>& kernel, border_mode border = border_mode::zero)
+{
+	array<typename Mat::value_type> k(kernel.size());
+	impl_convolve::_load_kernel(kernel, k.data(), false);
+	return impl_convolve::_correlate(m, k.data(), kernel.rows(), kernel.columns(), border);
+}
+
+// Correlation with the kernel rotated by 180 degrees.
+template<class Mat
+	,class Kernel
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename Mat::value_type, typename Kernel::value_type>> = 0
+#endif
+>
+auto
+convolve2d(const _matrix_base<Mat>& m, const _matrix_base<Kernel>& kernel, border_mode border = border_mode::zero)
+{
+	array<typename Mat::value_type> k(kernel.size());
+	impl_convolve::_load_kernel(kernel, k.data(), true);
+	return impl_convolve::_correlate(m, k.data(), kernel.rows(), kernel.columns(), border);
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,737 @@
+#ifndef MTK_LINALG_DECOMPOSITION_HPP
+#define MTK_LINALG_DECOMPOSITION_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/move.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/core/impl/swap.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/gemm.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace mtk {
+namespace impl_decomposition {
+
+template<class T>
+impl_matrix::_real_type_t<T>
+_abs_squared(const T& val)
+{
+	if constexpr (impl_matrix::_is_complex<T>::value)
+		return val.real()*val.real() + val.imag()*val.imag();
+	else
+		return val*val;
+}
+
+template<class T>
+impl_matrix::_real_type_t<T>
+_real(const T& val)
+{
+	if constexpr (impl_matrix::_is_complex<T>::value)
+		return val.real();
+	else
+		return val;
+}
+
+template<class T>
+impl_matrix::_real_type_t<T>
+_imag(const T& val)
+{
+	if constexpr (impl_matrix::_is_complex<T>::value)
+		return val.imag();
+	else
+		return impl_matrix::_real_type_t<T>();
+}
+
+} // namespace impl_decomposition
+
+
+
+// P*A = L*U with partial pivoting, L has a unit diagonal and shares the row major storage with U.
+// Complex pivots are chosen by |re| + |im|.
+// A is singular when a pivot is at most size()*eps*max(max|A_ij|, max|U_ij|), the second term covers element growth.
+// The test is numerical: a matrix that is singular only up to the rounding of its entries may still be reported
+// regular, its pivot a few hundred eps of the scale. Check the condition when that matters.
+template<class Scalar>
+class lu_decomposition
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using matrix_type = matrix<Scalar, dynamic_extent, dynamic_extent>;
+
+	lu_decomposition() :
+		m_lu(),
+		m_perm(),
+		m_size(),
+		m_swaps(),
+		m_scale(),
+		m_singular()
+	{ }
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+#endif
+	>
+	explicit
+	lu_decomposition(const _matrix_base<Mat>& m) :
+		m_lu(m.rows()*m.columns()),
+		m_perm(m.rows()),
+		m_size(m.rows()),
+		m_swaps(),
+		m_scale(),
+		m_singular()
+	{
+		MTK_ASSERT(m.rows() == m.columns());
+
+		const size_type n = m_size;
+		for (size_type row = 0; row < n; ++row) {
+			m_perm[row] = row;
+			for (size_type col = 0; col < n; ++col)
+				m_lu[row*n + col] = m.value(row, col);
+		}
+
+		this->_factor();
+	}
+
+	size_type
+	size() const noexcept
+	{
+		return m_size;
+	}
+
+	// Heuristic after rank_update() as after a factorization, see the class comment.
+	bool
+	is_singular() const noexcept
+	{
+		return m_singular;
+	}
+
+	// Row i of P*A is row permutation()[i] of A.
+	const array<size_type>&
+	permutation() const noexcept
+	{
+		return m_perm;
+	}
+
+	value_type
+	determinant() const
+	{
+		value_type ret = (m_swaps % 2 == 0 ? value_type(1) : value_type(-1));
+		for (size_type i = 0; i < m_size; ++i)
+			ret = impl_matrix::_mul(ret, m_lu[i*m_size + i]);
+
+		return ret;
+	}
+
+	matrix_type
+	lower() const
+	{
+		matrix_type ret(m_size, m_size);
+		for (size_type row = 0; row < m_size; ++row) {
+			for (size_type col = 0; col < row; ++col)
+				ret.value(row, col) = m_lu[row*m_size + col];
+			ret.value(row, row) = value_type(1);
+		}
+
+		return ret;
+	}
+
+	matrix_type
+	upper() const
+	{
+		matrix_type ret(m_size, m_size);
+		for (size_type row = 0; row < m_size; ++row) {
+			for (size_type col = row; col < m_size; ++col)
+				ret.value(row, col) = m_lu[row*m_size + col];
+		}
+
+		return ret;
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, Scalar>> = 0
+#endif
+	>
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		MTK_ASSERT(rhs.rows() == m_size);
+
+		using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, Other::row_dimension, Other::column_dimension, Other::options>;
+
+		if (m_singular)
+			return std::optional<ret_type>();
+
+		const size_type cols = rhs.columns();
+		array<value_type> x(m_size*cols);
+		for (size_type row = 0; row < m_size; ++row) {
+			for (size_type col = 0; col < cols; ++col)
+				x[row*cols + col] = rhs.value(m_perm[row], col);
+		}
+
+		this->_substitute(x.data(), cols);
+
+		ret_type ret(rhs);
+		for (size_type row = 0; row < m_size; ++row) {
+			for (size_type col = 0; col < cols; ++col)
+				ret.value(row, col) = x[row*cols + col];
+		}
+
+		return std::optional<ret_type>(mtk::_move(ret));
+	}
+
+	std::optional<matrix_type>
+	inverted() const
+	{
+		if (m_singular)
+			return std::optional<matrix_type>();
+
+		matrix_type ret(m_size, m_size);
+		for (size_type row = 0; row < m_size; ++row)
+			ret.value(row, m_perm[row]) = value_type(1);
+
+		this->_substitute(ret.data(), m_size);
+		return std::optional<matrix_type>(mtk::_move(ret));
+	}
+
+	// Refactors for A + u*v^T in O(n^2) per column of u and v (Bennett's algorithm).
+	// The transpose is not conjugated for complex scalars.
+	// The pivots are kept, a column whose update cancels a pivot falls back to a full O(n^3) refactorization.
+	template<class MatU
+		,class MatV
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename MatU::value_type, Scalar>> = 0
+		,_require<std::is_same_v<typename MatV::value_type, Scalar>> = 0
+#endif
+	>
+	void
+	rank_update(const _matrix_base<MatU>& u, const _matrix_base<MatV>& v)
+	{
+		MTK_ASSERT((u.rows() == m_size) && (v.rows() == m_size));
+		MTK_ASSERT(u.columns() == v.columns());
+
+		const size_type n = m_size;
+		array<value_type> x(n);
+		array<value_type> y(n);
+		array<value_type> saved(n*n);
+		for (size_type col = 0; col < u.columns(); ++col) {
+			for (size_type i = 0; i < n; ++i) {
+				x[i] = u.value(m_perm[i], col);
+				y[i] = v.value(i, col);
+			}
+
+			for (size_type i = 0; i < n*n; ++i)
+				saved[i] = m_lu[i];
+
+			if (this->_update(x.data(), y.data()))
+				continue;
+
+			for (size_type i = 0; i < n; ++i) {
+				x[i] = u.value(m_perm[i], col);
+				y[i] = v.value(i, col);
+			}
+
+			this->_refactor(saved.data(), x.data(), y.data());
+		}
+	}
+
+	// Solves L*U*x = x in place, x is a row major size() x cols matrix already permuted by P.
+	void
+	_substitute(value_type* x, size_type cols) const
+	{
+		const size_type n = m_size;
+		for (size_type row = 1; row < n; ++row) {
+			for (size_type k = 0; k < row; ++k)
+				impl_gemm::_axpy(-m_lu[row*n + k], x + k*cols, x + row*cols, cols);
+		}
+
+		for (size_type i = 0; i < n; ++i) {
+			const size_type row = n - 1 - i;
+			for (size_type k = row + 1; k < n; ++k)
+				impl_gemm::_axpy(-m_lu[row*n + k], x + k*cols, x + row*cols, cols);
+
+			const value_type inv = value_type(1) / m_lu[row*n + row];
+			for (size_type col = 0; col < cols; ++col)
+				x[row*cols + col] = impl_matrix::_mul(x[row*cols + col], inv);
+		}
+	}
+
+private:
+	// Factors m_lu in place, row swaps are recorded on top of the current m_perm and m_swaps.
+	void
+	_factor()
+	{
+		const size_type n = m_size;
+		m_scale = impl_matrix::_real_type_t<value_type>();
+		for (size_type i = 0; i < n*n; ++i)
+			m_scale = mtk::_max(m_scale, impl_matrix::_lu_abs(m_lu[i]));
+
+		for (size_type k = 0; k < n; ++k) {
+			size_type pivot = k;
+			auto pivot_abs = impl_matrix::_lu_abs(m_lu[k*n + k]);
+			for (size_type row = k + 1; row < n; ++row) {
+				const auto val = impl_matrix::_lu_abs(m_lu[row*n + k]);
+				if (val > pivot_abs) {
+					pivot = row;
+					pivot_abs = val;
+				}
+			}
+
+			if (pivot != k) {
+				for (size_type col = 0; col < n; ++col)
+					mtk::_swap(m_lu[k*n + col], m_lu[pivot*n + col]);
+				mtk::_swap(m_perm[k], m_perm[pivot]);
+				++m_swaps;
+			}
+
+			const value_type diag = m_lu[k*n + k];
+			if (diag == value_type())
+				continue;
+
+			const value_type* pivot_row = m_lu.data() + k*n + k + 1;
+			for (size_type row = k + 1; row < n; ++row) {
+				value_type* cur = m_lu.data() + row*n;
+				const value_type factor = cur[k] / diag;
+				cur[k] = factor;
+				impl_gemm::_axpy(-factor, pivot_row, cur + k + 1, n - k - 1);
+			}
+		}
+
+		this->_check_pivots();
+	}
+
+	void
+	_check_pivots()
+	{
+		using real_type = impl_matrix::_real_type_t<value_type>;
+
+		const size_type n = m_size;
+		real_type growth = m_scale;
+		for (size_type row = 0; row < n; ++row) {
+			for (size_type col = row; col < n; ++col)
+				growth = mtk::_max(growth, impl_matrix::_lu_abs(m_lu[row*n + col]));
+		}
+
+		const real_type tolerance = real_type(n)*std::numeric_limits<real_type>::epsilon()*growth;
+		m_singular = false;
+		for (size_type k = 0; k < n; ++k) {
+			if (!(impl_matrix::_lu_abs(m_lu[k*n + k]) > tolerance))
+				m_singular = true;
+		}
+	}
+
+	// L*U += x*y^T without pivoting, x and y are overwritten.
+	// Returns false when a pivot loses half of its digits, m_lu is then left partially updated. The caller then
+	// refactorizes, so a cancelled pivot is judged from the refactorized matrix rather than the update's rounding.
+	// max|A_ij| is not known afterwards, m_scale becomes the bound max|A_ij| + max|x_i|*max|y_j|.
+	bool
+	_update(value_type* x, value_type* y)
+	{
+		using real_type = impl_matrix::_real_type_t<value_type>;
+
+		const size_type n = m_size;
+		const real_type tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+		real_type max_x = real_type();
+		real_type max_y = real_type();
+		for (size_type i = 0; i < n; ++i) {
+			max_x = mtk::_max(max_x, impl_matrix::_lu_abs(x[i]));
+			max_y = mtk::_max(max_y, impl_matrix::_lu_abs(y[i]));
+		}
+
+		for (size_type k = 0; k < n; ++k) {
+			value_type* row = m_lu.data() + k*n;
+			const value_type delta = impl_matrix::_mul(x[k], y[k]);
+			const real_type scale = impl_matrix::_lu_abs(row[k]) + impl_matrix::_lu_abs(delta);
+			row[k] += delta;
+			if (!(impl_matrix::_lu_abs(row[k]) > tolerance*scale))
+				return false;
+
+			const value_type beta = y[k] / row[k];
+			impl_gemm::_axpy(x[k], y + k + 1, row + k + 1, n - k - 1);
+			impl_gemm::_axpy(-beta, row + k + 1, y + k + 1, n - k - 1);
+			for (size_type i = k + 1; i < n; ++i) {
+				value_type& l = m_lu[i*n + k];
+				x[i] -= impl_matrix::_mul(x[k], l);
+				l += impl_matrix::_mul(x[i], beta);
+			}
+		}
+
+		m_scale += max_x*max_y;
+		this->_check_pivots();
+		return true;
+	}
+
+	// m_lu = factors(L*U + x*y^T) from the factors lu saved before the update.
+	void
+	_refactor(const value_type* lu, const value_type* x, const value_type* y)
+	{
+		const size_type n = m_size;
+		for (size_type row = 0; row < n; ++row) {
+			value_type* dst = m_lu.data() + row*n;
+			for (size_type col = 0; col < n; ++col)
+				dst[col] = impl_matrix::_mul(x[row], y[col]);
+
+			// Row of L times U, the unit diagonal of L picks the row of U itself.
+			for (size_type k = 0; k < row; ++k)
+				impl_gemm::_axpy(lu[row*n + k], lu + k*n + k, dst + k, n - k);
+			impl_gemm::_axpy(value_type(1), lu + row*n + row, dst + row, n - row);
+		}
+
+		this->_factor();
+	}
+
+	array<value_type> m_lu;
+	array<size_type> m_perm;
+	size_type m_size;
+	size_type m_swaps;
+	impl_matrix::_real_type_t<value_type> m_scale;
+	bool m_singular;
+};
+
+
+
+// A = Q*R with Householder reflectors H_k = I - tau_k*v_k*v_k^H, stored column major
+// below the diagonal with the leading 1 of each v_k implied.
+// For complex scalars tau is complex and R has a real diagonal, as in LAPACK.
+template<class Scalar>
+class qr_decomposition
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using matrix_type = matrix<Scalar, dynamic_extent, dynamic_extent>;
+
+	qr_decomposition() :
+		m_qr(),
+		m_tau(),
+		m_rows(),
+		m_cols()
+	{ }
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+#endif
+	>
+	explicit
+	qr_decomposition(const _matrix_base<Mat>& m) :
+		m_qr(m.rows()*m.columns()),
+		m_tau(mtk::_min(m.rows(), m.columns())),
+		m_rows(m.rows()),
+		m_cols(m.columns())
+	{
+		using real_type = impl_matrix::_real_type_t<value_type>;
+
+		for (size_type col = 0; col < m_cols; ++col) {
+			for (size_type row = 0; row < m_rows; ++row)
+				m_qr[col*m_rows + row] = m.value(row, col);
+		}
+
+		const size_type count = m_tau.size();
+		for (size_type k = 0; k < count; ++k) {
+			value_type* v = m_qr.data() + k*m_rows + k;
+			const size_type len = m_rows - k;
+
+			real_type tail = real_type();
+			for (size_type i = 1; i < len; ++i)
+				tail += impl_decomposition::_abs_squared(v[i]);
+
+			const value_type alpha = v[0];
+			if ((tail == real_type()) && (impl_decomposition::_imag(alpha) == real_type())) {
+				m_tau[k] = value_type();
+				continue;
+			}
+
+			const real_type norm = std::sqrt(impl_decomposition::_abs_squared(alpha) + tail);
+			const real_type beta = (impl_decomposition::_real(alpha) >= real_type() ? -norm : norm);
+			m_tau[k] = (value_type(beta) - alpha) / beta;
+
+			const value_type scale = value_type(1) / (alpha - value_type(beta));
+			for (size_type i = 1; i < len; ++i)
+				v[i] = impl_matrix::_mul(v[i], scale);
+			v[0] = value_type(beta);
+
+			for (size_type col = k + 1; col < m_cols; ++col)
+				this->_reflect(k, impl_matrix::_conj(m_tau[k]), m_qr.data() + col*m_rows);
+		}
+	}
+
+	size_type
+	rows() const noexcept
+	{
+		return m_rows;
+	}
+
+	size_type
+	columns() const noexcept
+	{
+		return m_cols;
+	}
+
+	// The thin factor, rows() x min(rows(), columns()) with orthonormal columns.
+	matrix_type
+	q() const
+	{
+		const size_type count = m_tau.size();
+		array<value_type> q(m_rows*count);
+		for (size_type i = 0; i < count; ++i)
+			q[i*m_rows + i] = value_type(1);
+
+		for (size_type n = 0; n < count; ++n) {
+			const size_type k = count - 1 - n;
+			for (size_type col = k; col < count; ++col)
+				this->_reflect(k, m_tau[k], q.data() + col*m_rows);
+		}
+
+		matrix_type ret(m_rows, count);
+		for (size_type row = 0; row < m_rows; ++row) {
+			for (size_type col = 0; col < count; ++col)
+				ret.value(row, col) = q[col*m_rows + row];
+		}
+
+		return ret;
+	}
+
+	// min(rows(), columns()) x columns(), upper trapezoidal.
+	matrix_type
+	r() const
+	{
+		const size_type count = m_tau.size();
+		matrix_type ret(count, m_cols);
+		for (size_type row = 0; row < count; ++row) {
+			for (size_type col = row; col < m_cols; ++col)
+				ret.value(row, col) = m_qr[col*m_rows + row];
+		}
+
+		return ret;
+	}
+
+	// Numerical rank, a diagonal entry of R at most max(rows(), columns())*eps*max|R_jj| counts as zero.
+	bool
+	is_full_rank() const
+	{
+		using real_type = impl_matrix::_real_type_t<value_type>;
+
+		const size_type count = m_tau.size();
+		if (count != m_cols)
+			return false;
+
+		real_type max_diag = real_type();
+		for (size_type i = 0; i < count; ++i)
+			max_diag = mtk::_max(max_diag, impl_matrix::_lu_abs(m_qr[i*m_rows + i]));
+
+		const real_type tolerance = real_type(mtk::_max(m_rows, m_cols))*std::numeric_limits<real_type>::epsilon()*max_diag;
+		for (size_type i = 0; i < count; ++i) {
+			if (!(impl_matrix::_lu_abs(m_qr[i*m_rows + i]) > tolerance))
+				return false;
+		}
+
+		return true;
+	}
+
+	// Least squares solution minimizing |A*x - rhs|, requires rows() >= columns() and full rank.
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, Scalar>> = 0
+#endif
+	>
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		MTK_ASSERT(rhs.rows() == m_rows);
+
+		using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, dynamic_extent, Other::column_dimension, Other::options>;
+
+		if (!this->is_full_rank())
+			return std::optional<ret_type>();
+
+		const size_type cols = rhs.columns();
+		array<value_type> x(m_rows*cols);
+		for (size_type col = 0; col < cols; ++col) {
+			for (size_type row = 0; row < m_rows; ++row)
+				x[col*m_rows + row] = rhs.value(row, col);
+		}
+
+		this->_apply_qh(x.data(), cols);
+
+		auto ret = mtk::_make_matrix<ret_type>(m_cols, cols);
+		for (size_type col = 0; col < cols; ++col) {
+			value_type* b = x.data() + col*m_rows;
+			for (size_type n = 0; n < m_cols; ++n) {
+				const size_type row = m_cols - 1 - n;
+				b[row] /= m_qr[row*m_rows + row];
+				impl_gemm::_axpy(-b[row], m_qr.data() + row*m_rows, b, row);
+			}
+
+			for (size_type row = 0; row < m_cols; ++row)
+				ret.value(row, col) = b[row];
+		}
+
+		return std::optional<ret_type>(mtk::_move(ret));
+	}
+
+	// x := Q^H*x, x holds cols column major columns of rows() elements.
+	void
+	_apply_qh(value_type* x, size_type cols) const
+	{
+		const size_type count = m_tau.size();
+		for (size_type col = 0; col < cols; ++col) {
+			for (size_type k = 0; k < count; ++k)
+				this->_reflect(k, impl_matrix::_conj(m_tau[k]), x + col*m_rows);
+		}
+	}
+
+private:
+	// a := (I - tau*v_k*v_k^H)*a for a column a of rows() elements.
+	void
+	_reflect(size_type k, value_type tau, value_type* a) const
+	{
+		if (tau == value_type())
+			return;
+
+		const value_type* v = m_qr.data() + k*m_rows + k;
+		const size_type len = m_rows - k;
+		value_type w = a[k];
+		for (size_type i = 1; i < len; ++i)
+			w += impl_matrix::_mul(impl_matrix::_conj(v[i]), a[k + i]);
+
+		const value_type factor = -impl_matrix::_mul(tau, w);
+		a[k] += factor;
+		impl_gemm::_axpy(factor, v + 1, a + k + 1, len - 1);
+	}
+
+	array<value_type> m_qr;
+	array<value_type> m_tau;
+	size_type m_rows;
+	size_type m_cols;
+};
+
+
+
+// Turns inv = A^-1 into (A + u*v^T)^-1 in O(n^2*k) for n x k matrices u and v,
+// Sherman-Morrison for k == 1 and Woodbury otherwise. The transpose is not conjugated for complex scalars.
+// Returns false and leaves inv unchanged if A + u*v^T is singular, a numerical test as for lu_decomposition.
+template<class Mat
+	,class MatU
+	,class MatV
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename Mat::value_type, typename MatU::value_type>> = 0
+	,_require<std::is_same_v<typename Mat::value_type, typename MatV::value_type>> = 0
+#endif
+>
+bool
+inverse_rank_update(_matrix_base<Mat>& inv, const _matrix_base<MatU>& u, const _matrix_base<MatV>& v)
+{
+	MTK_ASSERT(inv.rows() == inv.columns());
+	MTK_ASSERT((u.rows() == inv.rows()) && (v.rows() == inv.rows()));
+	MTK_ASSERT(u.columns() == v.columns());
+
+	using value_type = typename Mat::value_type;
+
+	const size_t n = inv.rows();
+	const size_t k = u.columns();
+	if ((n == 0) || (k == 0))
+		return true;
+
+	array<value_type> buf(impl_gemm::_has_contiguous_rows<Mat> ? 0 : n*n);
+	value_type* a;
+	if constexpr (impl_gemm::_has_contiguous_rows<Mat>) {
+		a = &inv.value(0, 0);
+	} else {
+		a = buf.data();
+		for (size_t row = 0; row < n; ++row) {
+			for (size_t col = 0; col < n; ++col)
+				a[row*n + col] = inv.value(row, col);
+		}
+	}
+
+	// z = inv*u (n x k), w = v^T*inv (k x n).
+	array<value_type> ut(k*n);
+	array<value_type> w(k*n);
+	array<value_type> z(n*k);
+	for (size_t row = 0; row < n; ++row) {
+		for (size_t col = 0; col < k; ++col)
+			ut[col*n + row] = u.value(row, col);
+	}
+
+	for (size_t row = 0; row < n; ++row) {
+		for (size_t col = 0; col < k; ++col) {
+			z[row*k + col] = impl_gemm::_dotu(a + row*n, ut.data() + col*n, n);
+			impl_gemm::_axpy(v.value(row, col), a + row*n, w.data() + col*n, n);
+		}
+	}
+
+	// w := (I + v^T*z)^-1*w
+	matrix<value_type, dynamic_extent, dynamic_extent> c(k, k);
+	for (size_t i = 0; i < k; ++i) {
+		c.value(i, i) = value_type(1);
+		for (size_t row = 0; row < n; ++row) {
+			const value_type vi = v.value(row, i);
+			impl_gemm::_axpy(vi, z.data() + row*k, &c.value(i, 0), k);
+		}
+	}
+
+	if (k == 1) {
+		// 1 + v^T*z is computed to about n*eps*(1 + |v|^T*|inv|*|u|), z = inv*u itself may cancel.
+		using real_type = impl_matrix::_real_type_t<value_type>;
+
+		real_type magnitude = real_type(1);
+		for (size_t row = 0; row < n; ++row) {
+			real_type z_abs = real_type();
+			for (size_t col = 0; col < n; ++col)
+				z_abs += impl_matrix::_lu_abs(a[row*n + col])*impl_matrix::_lu_abs(ut[col]);
+			magnitude += impl_matrix::_lu_abs(v.value(row, 0))*z_abs;
+		}
+
+		const value_type denom = c.value(0, 0);
+		if (!(impl_matrix::_lu_abs(denom) > real_type(n)*std::numeric_limits<real_type>::epsilon()*magnitude))
+			return false;
+
+		const value_type scale = value_type(1) / denom;
+		for (size_t col = 0; col < n; ++col)
+			w[col] = impl_matrix::_mul(w[col], scale);
+	} else {
+		const lu_decomposition<value_type> lu(c);
+		if (lu.is_singular())
+			return false;
+
+		array<value_type> tmp(k*n);
+		for (size_t row = 0; row < k; ++row) {
+			const value_type* src = w.data() + lu.permutation()[row]*n;
+			for (size_t col = 0; col < n; ++col)
+				tmp[row*n + col] = src[col];
+		}
+
+		lu._substitute(tmp.data(), n);
+		w = mtk::_move(tmp);
+	}
+
+	// inv -= z*w
+	for (size_t row = 0; row < n; ++row) {
+		for (size_t col = 0; col < k; ++col)
+			impl_gemm::_axpy(-z[row*k + col], w.data() + col*n, a + row*n, n);
+	}
+
+	if constexpr (!impl_gemm::_has_contiguous_rows<Mat>) {
+		for (size_t row = 0; row < n; ++row) {
+			for (size_t col = 0; col < n; ++col)
+				inv.value(row, col) = a[row*n + col];
+		}
+	}
+
+	return true;
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef MTK_LINALG_DIAGONAL_HPP
+#define MTK_LINALG_DIAGONAL_HPP
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <optional>
+#include <type_traits>
+
+namespace mtk {
+
+template<class Scalar
+	,size_t Size>
+class diagonal_matrix
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using diagonal_type = vector<Scalar, Size>;
+
+	static constexpr
+	size_type
+	row_dimension = Size;
+
+	static constexpr
+	size_type
+	column_dimension = Size;
+
+	constexpr
+	diagonal_matrix() :
+		m_diag()
+	{ }
+
+	template<size_t S = Size
+#ifndef MTK_DOXYGEN
+		,_require<(S == dynamic_extent)> = 0
+#endif
+	>
+	explicit
+	diagonal_matrix(size_type size) :
+		m_diag(size)
+	{ }
+
+	template<class Vec
+#ifndef MTK_DOXYGEN
+		,_require<_is_matrix_compatible<diagonal_type, Vec>::value> = 0
+#endif
+	>
+	explicit constexpr
+	diagonal_matrix(const _matrix_base<Vec>& diag) :
+		m_diag(diag)
+	{ }
+
+	constexpr
+	size_type
+	rows() const
+	{
+		return m_diag.size();
+	}
+
+	constexpr
+	size_type
+	columns() const
+	{
+		return m_diag.size();
+	}
+
+	constexpr
+	value_type&
+	value(size_type i)
+	{
+		return m_diag.value(i);
+	}
+
+	constexpr
+	const value_type&
+	value(size_type i) const
+	{
+		return m_diag.value(i);
+	}
+
+	constexpr
+	value_type
+	value(size_type row, size_type col) const
+	{
+		return (row == col ? m_diag.value(row) : value_type());
+	}
+
+	constexpr
+	const diagonal_type&
+	diagonal() const
+	{
+		return m_diag;
+	}
+
+	constexpr
+	value_type
+	determinant() const
+	{
+		value_type ret = value_type(1);
+		for (const auto& el : m_diag)
+			ret *= el;
+
+		return ret;
+	}
+
+	constexpr
+	std::optional<diagonal_matrix>
+	inverted() const
+	{
+		diagonal_matrix ret = *this;
+		for (auto& el : ret.m_diag) {
+			if (el == value_type())
+				return std::optional<diagonal_matrix>();
+
+			el = value_type(1) / el;
+		}
+
+		return std::optional<diagonal_matrix>(mtk::_move(ret));
+	}
+
+	constexpr
+	auto
+	to_dense() const
+	{
+		const auto size = this->rows();
+		auto ret = mtk::_make_matrix<matrix<value_type, Size, Size>>(size, size);
+		for (size_type i = 0; i < size; ++i)
+			ret.value(i, i) = m_diag.value(i);
+
+		return ret;
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, value_type>> = 0
+#endif
+	>
+	constexpr
+	void
+	solve_in_place(_matrix_base<Other>& rhs) const
+	{
+		MTK_ASSERT(rhs.rows() == this->rows());
+
+		const auto rows = rhs.rows();
+		const auto cols = rhs.columns();
+		for (size_type row = 0; row < rows; ++row) {
+			const value_type diag = m_diag.value(row);
+			for (size_type col = 0; col < cols; ++col)
+				rhs.value(row, col) /= diag;
+		}
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, value_type>> = 0
+#endif
+	>
+	constexpr
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, Other::row_dimension, Other::column_dimension, Other::options>;
+
+		ret_type ret(rhs);
+		this->solve_in_place(ret);
+		return ret;
+	}
+
+	constexpr
+	diagonal_matrix&
+	operator*=(const diagonal_matrix& rhs)
+	{
+		MTK_ASSERT(this->rows() == rhs.rows());
+
+		const auto size = this->rows();
+		for (size_type i = 0; i < size; ++i)
+			m_diag.value(i) *= rhs.m_diag.value(i);
+
+		return *this;
+	}
+
+	constexpr
+	diagonal_matrix&
+	operator*=(value_type rhs)
+	{
+		m_diag *= rhs;
+		return *this;
+	}
+
+private:
+	diagonal_type m_diag;
+};
+
+
+
+template<class Scalar
+	,size_t Size>
+constexpr
+diagonal_matrix<Scalar, Size>
+operator*(diagonal_matrix<Scalar, Size> lhs, const diagonal_matrix<Scalar, Size>& rhs)
+{
+	return lhs *= rhs;
+}
+
+template<class Scalar
+	,size_t Size
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<Scalar, typename Mat::value_type>> = 0
+	,_require<(Size == Mat::row_dimension)> = 0
+#endif
+>
+constexpr
+auto
+operator*(const diagonal_matrix<Scalar, Size>& lhs, const _matrix_base<Mat>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Scalar, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	ret_type ret(rhs);
+	const auto rows = ret.rows();
+	const auto cols = ret.columns();
+	for (size_t row = 0; row < rows; ++row) {
+		const Scalar diag = lhs.value(row);
+		for (size_t col = 0; col < cols; ++col)
+			ret.value(row, col) *= diag;
+	}
+
+	return ret;
+}
+
+template<class Mat
+	,class Scalar
+	,size_t Size
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<Scalar, typename Mat::value_type>> = 0
+	,_require<(Mat::column_dimension == Size)> = 0
+#endif
+>
+constexpr
+auto
+operator*(const _matrix_base<Mat>& lhs, const diagonal_matrix<Scalar, Size>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Scalar, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	ret_type ret(lhs);
+	const auto rows = ret.rows();
+	const auto cols = ret.columns();
+	for (size_t row = 0; row < rows; ++row) {
+		for (size_t col = 0; col < cols; ++col)
+			ret.value(row, col) *= rhs.value(col);
+	}
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef MTK_LINALG_EXPONENTIAL_HPP
+#define MTK_LINALG_EXPONENTIAL_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/core/impl/swap.hpp>
+#include <mtk/linalg/decomposition.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/gemm.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <type_traits>
+
+namespace mtk {
+namespace impl_exponential {
+
+template<class Mat>
+inline constexpr
+bool
+_is_square_compatible = (Mat::row_dimension == Mat::column_dimension) || (Mat::row_dimension == dynamic_extent) || (Mat::column_dimension == dynamic_extent);
+
+template<class Mat>
+using _square_type = typename _linalg_traits<Mat>::template matrix_type<typename Mat::value_type, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+// Padé degrees with the largest 1-norm each one is accurate for, from Higham's 2005 scaling and squaring paper.
+// Single precision stops at degree 7.
+inline constexpr
+size_t
+_pade_degrees[] = {3, 5, 7, 9, 13};
+
+inline constexpr
+double
+_pade_theta_f32[] = {4.258730016922831e-1, 1.880152677804762e0, 3.925724783138660e0};
+
+inline constexpr
+double
+_pade_theta_f64[] = {1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0};
+
+inline
+const double*
+_pade_coefficients(size_t degree)
+{
+	static constexpr double b3[] = {120.0, 60.0, 12.0, 1.0};
+	static constexpr double b5[] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+	static constexpr double b7[] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+	static constexpr double b9[] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+		2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+	static constexpr double b13[] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0, 1187353796428800.0,
+		129060195264000.0, 10559470521600.0, 670442572800.0, 33522128640.0, 1323241920.0, 40840800.0, 960960.0,
+		16380.0, 182.0, 1.0};
+
+	switch (degree) {
+	case 3:
+		return b3;
+	case 5:
+		return b5;
+	case 7:
+		return b7;
+	case 9:
+		return b9;
+	default:
+		return b13;
+	}
+}
+
+template<class Mat
+	,class T>
+void
+_load(const _matrix_base<Mat>& m, T* dst)
+{
+	const size_t n = m.rows();
+	for (size_t row = 0; row < n; ++row) {
+		for (size_t col = 0; col < n; ++col)
+			dst[row*n + col] = m.value(row, col);
+	}
+}
+
+template<class Mat
+	,class T>
+void
+_store(const T* src, _matrix_base<Mat>& m)
+{
+	const size_t n = m.rows();
+	for (size_t row = 0; row < n; ++row) {
+		for (size_t col = 0; col < n; ++col)
+			m.value(row, col) = src[row*n + col];
+	}
+}
+
+// c = a*b, c must not alias a or b.
+template<class T>
+void
+_multiply(const T* a, const T* b, T* c, size_t n)
+{
+	impl_gemm::_gemm_kernel(a, n, b, n, c, n, n, n, n);
+}
+
+template<class T>
+impl_matrix::_real_type_t<T>
+_norm1(const T* a, size_t n)
+{
+	using real_type = impl_matrix::_real_type_t<T>;
+
+	real_type ret = real_type();
+	for (size_t col = 0; col < n; ++col) {
+		real_type sum = real_type();
+		for (size_t row = 0; row < n; ++row)
+			sum += std::abs(a[row*n + col]);
+		if (!(sum <= ret))
+			ret = sum;
+	}
+
+	return ret;
+}
+
+// dst = c*I
+template<class T>
+void
+_set_identity(T* dst, double c, size_t n)
+{
+	for (size_t i = 0; i < n*n; ++i)
+		dst[i] = T();
+	for (size_t i = 0; i < n; ++i)
+		dst[i*n + i] = T(c);
+}
+
+// a is n x n and is overwritten, work holds 7 more n x n matrices.
+// Returns the slot holding the [degree/degree] approximant of exp(a).
+template<class T>
+T*
+_pade(T* a, T* work, size_t n, size_t degree)
+{
+	const size_t n2 = n*n;
+	const double* b = impl_exponential::_pade_coefficients(degree);
+	T* odd = work;
+	T* u = work + n2;
+	T* v = work + 2*n2;
+	T* a2 = work + 3*n2;
+
+	impl_exponential::_multiply(a, a, a2, n);
+	if (degree < 13) {
+		// Even powers a^2 ... a^(degree - 1) sit one after another from a2.
+		const size_t count = (degree - 1) / 2;
+		for (size_t k = 1; k < count; ++k)
+			impl_exponential::_multiply(a2 + (k - 1)*n2, a2, a2 + k*n2, n);
+
+		impl_exponential::_set_identity(odd, b[1], n);
+		impl_exponential::_set_identity(v, b[0], n);
+		for (size_t k = 0; k < count; ++k) {
+			impl_gemm::_axpy(T(b[2*k + 3]), a2 + k*n2, odd, n2);
+			impl_gemm::_axpy(T(b[2*k + 2]), a2 + k*n2, v, n2);
+		}
+	} else {
+		T* a4 = a2 + n2;
+		T* a6 = a2 + 2*n2;
+		T* tmp = a2 + 3*n2;
+		impl_exponential::_multiply(a2, a2, a4, n);
+		impl_exponential::_multiply(a4, a2, a6, n);
+
+		for (size_t i = 0; i < n2; ++i)
+			tmp[i] = T(b[13])*a6[i] + T(b[11])*a4[i] + T(b[9])*a2[i];
+		impl_exponential::_multiply(a6, tmp, odd, n);
+		impl_gemm::_axpy(T(b[7]), a6, odd, n2);
+		impl_gemm::_axpy(T(b[5]), a4, odd, n2);
+		impl_gemm::_axpy(T(b[3]), a2, odd, n2);
+		for (size_t i = 0; i < n; ++i)
+			odd[i*n + i] += T(b[1]);
+
+		for (size_t i = 0; i < n2; ++i)
+			tmp[i] = T(b[12])*a6[i] + T(b[10])*a4[i] + T(b[8])*a2[i];
+		impl_exponential::_multiply(a6, tmp, v, n);
+		impl_gemm::_axpy(T(b[6]), a6, v, n2);
+		impl_gemm::_axpy(T(b[4]), a4, v, n2);
+		impl_gemm::_axpy(T(b[2]), a2, v, n2);
+		for (size_t i = 0; i < n; ++i)
+			v[i*n + i] += T(b[0]);
+	}
+
+	impl_exponential::_multiply(a, odd, u, n);
+
+	// (v - u)*r = v + u
+	matrix<T, dynamic_extent, dynamic_extent> q(n, n, for_overwrite);
+	for (size_t i = 0; i < n2; ++i) {
+		q.data()[i] = v[i] - u[i];
+		v[i] += u[i];
+	}
+
+	const lu_decomposition<T> lu(q);
+	MTK_ASSERT(!lu.is_singular());
+
+	T* r = odd;
+	for (size_t row = 0; row < n; ++row) {
+		const T* src = v + lu.permutation()[row]*n;
+		for (size_t col = 0; col < n; ++col)
+			r[row*n + col] = src[col];
+	}
+
+	lu._substitute(r, n);
+	return r;
+}
+
+} // namespace impl_exponential
+
+
+
+// m^exponent by repeated squaring, pow(m, 0) is the identity.
+template<class Mat
+#ifndef MTK_DOXYGEN
+	,_require<impl_exponential::_is_square_compatible<Mat>> = 0
+#endif
+>
+auto
+pow(const _matrix_base<Mat>& m, size_t exponent)
+{
+	MTK_ASSERT(m.rows() == m.columns());
+
+	using value_type = typename Mat::value_type;
+	using ret_type = impl_exponential::_square_type<Mat>;
+
+	const size_t n = m.rows();
+	auto ret = mtk::_make_matrix<ret_type>(n, n);
+	if (n == 0)
+		return ret;
+
+	if (exponent == 0) {
+		for (size_t i = 0; i < n; ++i)
+			ret.value(i, i) = value_type(1);
+		return ret;
+	}
+
+	array<value_type> work(3*n*n, for_overwrite);
+	value_type* base = work.data();
+	value_type* acc = base + n*n;
+	value_type* tmp = acc + n*n;
+	impl_exponential::_load(m, base);
+
+	bool first = true;
+	while (true) {
+		if (exponent & 1) {
+			if (first) {
+				for (size_t i = 0; i < n*n; ++i)
+					acc[i] = base[i];
+				first = false;
+			} else {
+				impl_exponential::_multiply(acc, base, tmp, n);
+				mtk::_swap(acc, tmp);
+			}
+		}
+
+		exponent >>= 1;
+		if (exponent == 0)
+			break;
+
+		impl_exponential::_multiply(base, base, tmp, n);
+		mtk::_swap(base, tmp);
+	}
+
+	impl_exponential::_store(acc, ret);
+	return ret;
+}
+
+// Matrix exponential by scaling and squaring with a diagonal Padé approximant,
+// the degree and number of squarings are picked from the 1-norm of m.
+template<class Mat
+#ifndef MTK_DOXYGEN
+	,_require<impl_exponential::_is_square_compatible<Mat>> = 0
+	,_require<std::is_floating_point_v<impl_matrix::_real_type_t<typename Mat::value_type>>> = 0
+#endif
+>
+auto
+exp(const _matrix_base<Mat>& m)
+{
+	MTK_ASSERT(m.rows() == m.columns());
+
+	using value_type = typename Mat::value_type;
+	using real_type = impl_matrix::_real_type_t<value_type>;
+	using ret_type = impl_exponential::_square_type<Mat>;
+
+	const size_t n = m.rows();
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(n, n);
+	if (n == 0)
+		return ret;
+
+	array<value_type> work(8*n*n, for_overwrite);
+	value_type* a = work.data();
+	value_type* tmp = a + n*n;
+	impl_exponential::_load(m, a);
+
+	constexpr bool single = std::is_same_v<real_type, float>;
+	const double* theta = (single ? impl_exponential::_pade_theta_f32 : impl_exponential::_pade_theta_f64);
+	const size_t degrees = (single ? 3 : 5);
+	const double norm = double(impl_exponential::_norm1(a, n));
+
+	size_t degree = impl_exponential::_pade_degrees[degrees - 1];
+	for (size_t i = 0; i + 1 < degrees; ++i) {
+		if (norm <= theta[i]) {
+			degree = impl_exponential::_pade_degrees[i];
+			break;
+		}
+	}
+
+	int squarings = 0;
+	if (std::isfinite(norm) && (norm > theta[degrees - 1])) {
+		squarings = int(std::ceil(std::log2(norm / theta[degrees - 1])));
+		const value_type scale = value_type(std::ldexp(real_type(1), -squarings));
+		for (size_t i = 0; i < n*n; ++i)
+			a[i] *= scale;
+	}
+
+	value_type* r = impl_exponential::_pade(a, tmp, n, degree);
+	value_type* other = a;
+	for (int i = 0; i < squarings; ++i) {
+		impl_exponential::_multiply(r, r, other, n);
+		mtk::_swap(r, other);
+	}
+
+	impl_exponential::_store(r, ret);
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
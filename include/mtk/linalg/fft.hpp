@@ -0,0 +1,834 @@
+#ifndef MTK_LINALG_FFT_HPP
+#define MTK_LINALG_FFT_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/math.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/parallel.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/core/impl/swap.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+
+namespace mtk {
+namespace impl_fft {
+
+// Prime factors above this use Bluestein's algorithm on the whole transform.
+inline constexpr
+size_t
+_bluestein_threshold = 32;
+
+// Complex elements per parallel task in the 2d transforms.
+inline constexpr
+size_t
+_parallel_grain = size_t(1) << 16;
+
+// Columns gathered per pass in the 2d transforms.
+inline constexpr
+size_t
+_column_block = 8;
+
+template<class T>
+std::complex<T>
+_mul_neg_i(std::complex<T> val)
+{
+	return std::complex<T>(val.imag(), -val.real());
+}
+
+// exp(-2*pi*i*num/den)
+template<class T>
+std::complex<T>
+_root(size_t num, size_t den)
+{
+	const long double angle = -2*math::pi<long double>*static_cast<long double>(num % den) / static_cast<long double>(den);
+	return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+// One Stockham pass of radix r over n = r*m points, s interleaved transforms:
+// a_k = x[q + s*(p + k*m)], y[q + s*(r*p + j)] = w^(j*p)*sum of a_k*e^(-2*pi*i*j*k/r).
+// Twiddles are stored as w[(j - 1)*m + p].
+struct _stage
+{
+	size_t radix;
+	size_t m;
+	size_t stride;
+	size_t twiddles;
+	size_t roots;
+};
+
+template<class T>
+void
+_butterfly2(const std::complex<T>* x, std::complex<T>* y, const std::complex<T>* w, size_t m, size_t s)
+{
+	for (size_t p = 0; p < m; ++p) {
+		const std::complex<T> w1 = w[p];
+		for (size_t q = 0; q < s; ++q) {
+			const std::complex<T> a0 = x[q + s*p];
+			const std::complex<T> a1 = x[q + s*(p + m)];
+			y[q + s*(2*p)] = a0 + a1;
+			y[q + s*(2*p + 1)] = impl_matrix::_mul(a0 - a1, w1);
+		}
+	}
+}
+
+template<class T>
+void
+_butterfly3(const std::complex<T>* x, std::complex<T>* y, const std::complex<T>* w, size_t m, size_t s)
+{
+	const T half_sqrt3 = static_cast<T>(0.866025403784438646763723170752936183L);
+	for (size_t p = 0; p < m; ++p) {
+		const std::complex<T> w1 = w[p];
+		const std::complex<T> w2 = w[m + p];
+		for (size_t q = 0; q < s; ++q) {
+			const std::complex<T> a0 = x[q + s*p];
+			const std::complex<T> a1 = x[q + s*(p + m)];
+			const std::complex<T> a2 = x[q + s*(p + 2*m)];
+			const std::complex<T> t1 = a1 + a2;
+			const std::complex<T> t2 = a0 - t1*T(0.5);
+			const std::complex<T> t3 = impl_fft::_mul_neg_i(a1 - a2)*half_sqrt3;
+			y[q + s*(3*p)] = a0 + t1;
+			y[q + s*(3*p + 1)] = impl_matrix::_mul(t2 + t3, w1);
+			y[q + s*(3*p + 2)] = impl_matrix::_mul(t2 - t3, w2);
+		}
+	}
+}
+
+template<class T>
+void
+_butterfly4(const std::complex<T>* x, std::complex<T>* y, const std::complex<T>* w, size_t m, size_t s)
+{
+	for (size_t p = 0; p < m; ++p) {
+		const std::complex<T> w1 = w[p];
+		const std::complex<T> w2 = w[m + p];
+		const std::complex<T> w3 = w[2*m + p];
+		for (size_t q = 0; q < s; ++q) {
+			const std::complex<T> a0 = x[q + s*p];
+			const std::complex<T> a1 = x[q + s*(p + m)];
+			const std::complex<T> a2 = x[q + s*(p + 2*m)];
+			const std::complex<T> a3 = x[q + s*(p + 3*m)];
+			const std::complex<T> t0 = a0 + a2;
+			const std::complex<T> t1 = a0 - a2;
+			const std::complex<T> t2 = a1 + a3;
+			const std::complex<T> t3 = impl_fft::_mul_neg_i(a1 - a3);
+			y[q + s*(4*p)] = t0 + t2;
+			y[q + s*(4*p + 1)] = impl_matrix::_mul(t1 + t3, w1);
+			y[q + s*(4*p + 2)] = impl_matrix::_mul(t0 - t2, w2);
+			y[q + s*(4*p + 3)] = impl_matrix::_mul(t1 - t3, w3);
+		}
+	}
+}
+
+template<class T>
+void
+_butterfly5(const std::complex<T>* x, std::complex<T>* y, const std::complex<T>* w, size_t m, size_t s)
+{
+	const T c1 = static_cast<T>(0.309016994374947424102293417182819059L);
+	const T c2 = static_cast<T>(-0.809016994374947424102293417182819059L);
+	const T s1 = static_cast<T>(0.951056516295153572116439333379382143L);
+	const T s2 = static_cast<T>(0.587785252292473129168705954639072769L);
+	for (size_t p = 0; p < m; ++p) {
+		const std::complex<T> w1 = w[p];
+		const std::complex<T> w2 = w[m + p];
+		const std::complex<T> w3 = w[2*m + p];
+		const std::complex<T> w4 = w[3*m + p];
+		for (size_t q = 0; q < s; ++q) {
+			const std::complex<T> a0 = x[q + s*p];
+			const std::complex<T> a1 = x[q + s*(p + m)];
+			const std::complex<T> a2 = x[q + s*(p + 2*m)];
+			const std::complex<T> a3 = x[q + s*(p + 3*m)];
+			const std::complex<T> a4 = x[q + s*(p + 4*m)];
+			const std::complex<T> t1 = a1 + a4;
+			const std::complex<T> t2 = a2 + a3;
+			const std::complex<T> t3 = a1 - a4;
+			const std::complex<T> t4 = a2 - a3;
+			const std::complex<T> u1 = a0 + t1*c1 + t2*c2;
+			const std::complex<T> u2 = a0 + t1*c2 + t2*c1;
+			const std::complex<T> v1 = impl_fft::_mul_neg_i(t3*s1 + t4*s2);
+			const std::complex<T> v2 = impl_fft::_mul_neg_i(t3*s2 - t4*s1);
+			y[q + s*(5*p)] = a0 + t1 + t2;
+			y[q + s*(5*p + 1)] = impl_matrix::_mul(u1 + v1, w1);
+			y[q + s*(5*p + 2)] = impl_matrix::_mul(u2 + v2, w2);
+			y[q + s*(5*p + 3)] = impl_matrix::_mul(u2 - v2, w3);
+			y[q + s*(5*p + 4)] = impl_matrix::_mul(u1 - v1, w4);
+		}
+	}
+}
+
+// Direct O(r^2) butterfly for the remaining small primes, roots[k] = e^(-2*pi*i*k/r).
+template<class T>
+void
+_butterfly(const std::complex<T>* x, std::complex<T>* y, const std::complex<T>* w, const std::complex<T>* roots, size_t r, size_t m, size_t s)
+{
+	for (size_t p = 0; p < m; ++p) {
+		for (size_t q = 0; q < s; ++q) {
+			for (size_t j = 0; j < r; ++j) {
+				std::complex<T> sum = x[q + s*p];
+				size_t root = 0;
+				for (size_t k = 1; k < r; ++k) {
+					root += j;
+					if (root >= r)
+						root -= r;
+
+					sum += impl_matrix::_mul(x[q + s*(p + k*m)], roots[root]);
+				}
+
+				y[q + s*(r*p + j)] = (j == 0 ? sum : impl_matrix::_mul(sum, w[(j - 1)*m + p]));
+			}
+		}
+	}
+}
+
+void
+_butterfly2(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s);
+
+void
+_butterfly2(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s);
+
+void
+_butterfly4(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s);
+
+void
+_butterfly4(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s);
+
+} // namespace impl_fft
+
+
+
+// Precomputed factorization and twiddles for complex transforms of one size.
+// Sizes made of 2, 3, 5 and other small primes run a self sorting mixed radix Stockham FFT,
+// sizes with a large prime factor are handled with Bluestein's algorithm.
+// The forward transform uses e^(-2*pi*i*j*k/n), the inverse is scaled by 1/n.
+// A plan is immutable after construction and can be shared between threads.
+template<class T>
+class fft_plan
+{
+public:
+	using value_type = std::complex<T>;
+	using size_type = size_t;
+
+	fft_plan() :
+		m_stages(),
+		m_twiddles(),
+		m_chirp(),
+		m_kernel(),
+		m_size(),
+		m_transform_size()
+	{ }
+
+	explicit
+	fft_plan(size_type size) :
+		fft_plan()
+	{
+		m_size = size;
+		if (size < 2) {
+			m_transform_size = size;
+			return;
+		}
+
+		size_type factors[64];
+		size_type count = fft_plan::_factorize(size, factors);
+		if (factors[count - 1] <= impl_fft::_bluestein_threshold) {
+			this->_init_stages(size, factors, count);
+			return;
+		}
+
+		size_type padded = 1;
+		while (padded < 2*size - 1)
+			padded *= 2;
+
+		count = fft_plan::_factorize(padded, factors);
+		this->_init_stages(padded, factors, count);
+
+		// chirp[k] = e^(-pi*i*k^2/n), k^2 is reduced modulo 2n to keep the angle exact.
+		m_chirp = array<value_type>(size);
+		for (size_type k = 0; k < size; ++k) {
+			const size_type k2 = static_cast<size_type>((static_cast<unsigned long long>(k)*k) % (2*size));
+			m_chirp[k] = impl_fft::_root<T>(k2, 2*size);
+		}
+
+		array<value_type> kernel(padded);
+		const T scale = T(1) / static_cast<T>(padded);
+		kernel[0] = std::conj(m_chirp[0])*scale;
+		for (size_type k = 1; k < size; ++k) {
+			kernel[k] = std::conj(m_chirp[k])*scale;
+			kernel[padded - k] = kernel[k];
+		}
+
+		array<value_type> work(padded);
+		m_kernel = array<value_type>(padded);
+		const value_type* ret = this->_run_stages(kernel.data(), work.data());
+		for (size_type k = 0; k < padded; ++k)
+			m_kernel[k] = ret[k];
+	}
+
+	size_type
+	size() const noexcept
+	{
+		return m_size;
+	}
+
+	void
+	forward(span<const value_type> in, span<value_type> out) const
+	{
+		this->_execute(in, out, false);
+	}
+
+	void
+	forward(span<value_type> data) const
+	{
+		this->_execute(data, data, false);
+	}
+
+	void
+	inverse(span<const value_type> in, span<value_type> out) const
+	{
+		this->_execute(in, out, true);
+	}
+
+	void
+	inverse(span<value_type> data) const
+	{
+		this->_execute(data, data, true);
+	}
+
+	size_type
+	_work_size() const noexcept
+	{
+		return (m_chirp.empty() ? m_size : 2*m_transform_size);
+	}
+
+	// in may alias out, work must hold _work_size() elements.
+	void
+	_execute(const value_type* in, value_type* out, value_type* work, bool inverse) const
+	{
+		if (m_size == 0)
+			return;
+
+		if (m_chirp.empty()) {
+			value_type* first = (m_stages.size() % 2 == 0 ? out : work);
+			if (inverse) {
+				for (size_type i = 0; i < m_size; ++i)
+					first[i] = std::conj(in[i]);
+			} else if (first != in) {
+				for (size_type i = 0; i < m_size; ++i)
+					first[i] = in[i];
+			}
+
+			this->_run_stages(first, (first == out ? work : out));
+		} else {
+			value_type* a = work;
+			value_type* b = work + m_transform_size;
+			for (size_type k = 0; k < m_size; ++k)
+				a[k] = impl_matrix::_mul((inverse ? std::conj(in[k]) : in[k]), m_chirp[k]);
+			for (size_type k = m_size; k < m_transform_size; ++k)
+				a[k] = value_type();
+
+			// The inverse transform of the convolution is the conjugated forward transform of its conjugate.
+			value_type* ret = this->_run_stages(a, b);
+			for (size_type k = 0; k < m_transform_size; ++k)
+				ret[k] = std::conj(impl_matrix::_mul(ret[k], m_kernel[k]));
+
+			ret = this->_run_stages(ret, (ret == a ? b : a));
+			for (size_type k = 0; k < m_size; ++k)
+				out[k] = impl_matrix::_mul(m_chirp[k], std::conj(ret[k]));
+		}
+
+		if (inverse) {
+			const T scale = T(1) / static_cast<T>(m_size);
+			for (size_type i = 0; i < m_size; ++i)
+				out[i] = std::conj(out[i])*scale;
+		}
+	}
+
+private:
+	static
+	size_type
+	_factorize(size_type size, size_type* factors)
+	{
+		size_type count = 0;
+		while (size % 4 == 0) {
+			factors[count++] = 4;
+			size /= 4;
+		}
+		while (size % 2 == 0) {
+			factors[count++] = 2;
+			size /= 2;
+		}
+		for (size_type f = 3; f*f <= size; f += 2) {
+			while (size % f == 0) {
+				factors[count++] = f;
+				size /= f;
+			}
+		}
+		if (size > 1)
+			factors[count++] = size;
+
+		return count;
+	}
+
+	void
+	_init_stages(size_type size, const size_type* factors, size_type count)
+	{
+		size_type twiddle_count = 0;
+		size_type n = size;
+		for (size_type i = 0; i < count; ++i) {
+			twiddle_count += (factors[i] - 1)*(n / factors[i]);
+			if (factors[i] > 5)
+				twiddle_count += factors[i];
+			n /= factors[i];
+		}
+
+		m_transform_size = size;
+		m_stages = array<impl_fft::_stage>(count);
+		m_twiddles = array<value_type>(twiddle_count);
+
+		size_type offset = 0;
+		size_type stride = 1;
+		n = size;
+		for (size_type i = 0; i < count; ++i) {
+			const size_type radix = factors[i];
+			const size_type m = n / radix;
+
+			impl_fft::_stage& stage = m_stages[i];
+			stage.radix = radix;
+			stage.m = m;
+			stage.stride = stride;
+			stage.twiddles = offset;
+			for (size_type j = 1; j < radix; ++j) {
+				for (size_type p = 0; p < m; ++p)
+					m_twiddles[offset++] = impl_fft::_root<T>(j*p, n);
+			}
+
+			stage.roots = offset;
+			if (radix > 5) {
+				for (size_type k = 0; k < radix; ++k)
+					m_twiddles[offset++] = impl_fft::_root<T>(k, radix);
+			}
+
+			stride *= radix;
+			n = m;
+		}
+	}
+
+	void
+	_execute(span<const value_type> in, span<value_type> out, bool inverse) const
+	{
+		MTK_ASSERT(in.size() == m_size);
+		MTK_ASSERT(out.size() == m_size);
+
+		array<value_type> work(this->_work_size());
+		this->_execute(in.data(), out.data(), work.data(), inverse);
+	}
+
+	// Ping-pongs between x and y, returns the buffer holding the result.
+	value_type*
+	_run_stages(value_type* x, value_type* y) const
+	{
+		for (const auto& stage : m_stages) {
+			const value_type* w = m_twiddles.data() + stage.twiddles;
+			switch (stage.radix) {
+			case 2:
+				impl_fft::_butterfly2(x, y, w, stage.m, stage.stride);
+				break;
+			case 3:
+				impl_fft::_butterfly3(x, y, w, stage.m, stage.stride);
+				break;
+			case 4:
+				impl_fft::_butterfly4(x, y, w, stage.m, stage.stride);
+				break;
+			case 5:
+				impl_fft::_butterfly5(x, y, w, stage.m, stage.stride);
+				break;
+			default:
+				impl_fft::_butterfly(x, y, w, m_twiddles.data() + stage.roots, stage.radix, stage.m, stage.stride);
+				break;
+			}
+
+			mtk::_swap(x, y);
+		}
+
+		return x;
+	}
+
+	array<impl_fft::_stage> m_stages;
+	array<value_type> m_twiddles;
+	array<value_type> m_chirp;
+	array<value_type> m_kernel;
+	size_type m_size;
+	size_type m_transform_size;
+};
+
+
+
+// Transforms of real sequences, forward produces the size()/2 + 1 non redundant coefficients.
+// Even sizes run a complex transform of half the size on the packed even and odd samples.
+template<class T>
+class real_fft_plan
+{
+public:
+	using value_type = std::complex<T>;
+	using size_type = size_t;
+
+	real_fft_plan() :
+		m_plan(),
+		m_twiddles(),
+		m_size()
+	{ }
+
+	explicit
+	real_fft_plan(size_type size) :
+		m_plan(size % 2 == 0 ? size / 2 : size),
+		m_twiddles(),
+		m_size(size)
+	{
+		if ((size % 2 == 0) && (size > 0)) {
+			m_twiddles = array<value_type>(size / 2 + 1);
+			for (size_type k = 0; k <= size / 2; ++k)
+				m_twiddles[k] = impl_fft::_root<T>(k, size);
+		}
+	}
+
+	size_type
+	size() const noexcept
+	{
+		return m_size;
+	}
+
+	size_type
+	spectrum_size() const noexcept
+	{
+		return (m_size == 0 ? 0 : m_size / 2 + 1);
+	}
+
+	void
+	forward(span<const T> in, span<value_type> out) const
+	{
+		MTK_ASSERT(in.size() == m_size);
+		MTK_ASSERT(out.size() == this->spectrum_size());
+
+		if (m_size == 0)
+			return;
+
+		const size_type count = m_plan.size();
+		array<value_type> buffer(count + m_plan._work_size());
+		value_type* z = buffer.data();
+		if (m_twiddles.empty()) {
+			for (size_type i = 0; i < count; ++i)
+				z[i] = value_type(in[i]);
+
+			m_plan._execute(z, z, z + count, false);
+			for (size_type k = 0; k < out.size(); ++k)
+				out[k] = z[k];
+
+			return;
+		}
+
+		for (size_type i = 0; i < count; ++i)
+			z[i] = value_type(in[2*i], in[2*i + 1]);
+
+		m_plan._execute(z, z, z + count, false);
+		for (size_type k = 0; k <= count; ++k) {
+			const value_type lhs = z[k == count ? 0 : k];
+			const value_type rhs = std::conj(z[k == 0 ? 0 : count - k]);
+			const value_type even = (lhs + rhs)*T(0.5);
+			const value_type odd = impl_fft::_mul_neg_i(lhs - rhs)*T(0.5);
+			out[k] = even + impl_matrix::_mul(m_twiddles[k], odd);
+		}
+	}
+
+	// Only the real parts of in[0] and in[size()/2] for even sizes are used.
+	void
+	inverse(span<const value_type> in, span<T> out) const
+	{
+		MTK_ASSERT(in.size() == this->spectrum_size());
+		MTK_ASSERT(out.size() == m_size);
+
+		if (m_size == 0)
+			return;
+
+		const size_type count = m_plan.size();
+		array<value_type> buffer(count + m_plan._work_size());
+		value_type* z = buffer.data();
+		if (m_twiddles.empty()) {
+			z[0] = value_type(in[0].real());
+			for (size_type k = 1; k < in.size(); ++k) {
+				z[k] = in[k];
+				z[count - k] = std::conj(in[k]);
+			}
+
+			m_plan._execute(z, z, z + count, true);
+			for (size_type i = 0; i < count; ++i)
+				out[i] = z[i].real();
+
+			return;
+		}
+
+		for (size_type k = 0; k < count; ++k) {
+			const value_type lhs = (k == 0 ? value_type(in[0].real()) : in[k]);
+			const value_type rhs = (k == 0 ? value_type(in[count].real()) : std::conj(in[count - k]));
+			const value_type even = (lhs + rhs)*T(0.5);
+			const value_type odd = impl_matrix::_mul(lhs - rhs, std::conj(m_twiddles[k]))*T(0.5);
+			z[k] = even + value_type(-odd.imag(), odd.real());
+		}
+
+		m_plan._execute(z, z, z + count, true);
+		for (size_type i = 0; i < count; ++i) {
+			out[2*i] = z[i].real();
+			out[2*i + 1] = z[i].imag();
+		}
+	}
+
+private:
+	fft_plan<T> m_plan;
+	array<value_type> m_twiddles;
+	size_type m_size;
+};
+
+
+
+// Row transforms followed by column transforms, columns are gathered in blocks
+// into contiguous buffers and both passes are spread over threads.
+template<class T>
+class fft_plan2d
+{
+public:
+	using value_type = std::complex<T>;
+	using size_type = size_t;
+	using matrix_type = matrix<value_type, dynamic_extent, dynamic_extent>;
+
+	fft_plan2d() :
+		m_row_plan(),
+		m_column_plan()
+	{ }
+
+	fft_plan2d(size_type rows, size_type cols) :
+		m_row_plan(cols),
+		m_column_plan(rows)
+	{ }
+
+	size_type
+	rows() const noexcept
+	{
+		return m_column_plan.size();
+	}
+
+	size_type
+	columns() const noexcept
+	{
+		return m_row_plan.size();
+	}
+
+	// Real input is promoted to complex.
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<impl_matrix::_real_type_t<typename Mat::value_type>, T>> = 0
+#endif
+	>
+	matrix_type
+	forward(const _matrix_base<Mat>& m) const
+	{
+		matrix_type ret = this->_load(m);
+		this->_execute(ret.data(), false);
+		return ret;
+	}
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<impl_matrix::_real_type_t<typename Mat::value_type>, T>> = 0
+#endif
+	>
+	matrix_type
+	inverse(const _matrix_base<Mat>& m) const
+	{
+		matrix_type ret = this->_load(m);
+		this->_execute(ret.data(), true);
+		return ret;
+	}
+
+	// data holds rows()*columns() elements in row major order.
+	void
+	_execute(value_type* data, bool inverse) const
+	{
+		const size_type rows = this->rows();
+		const size_type cols = this->columns();
+		if ((rows == 0) || (cols == 0))
+			return;
+
+		const size_type row_grain = mtk::_max(impl_fft::_parallel_grain / cols, size_type(1));
+		mtk::_parallel_for(rows, row_grain, [&](size_type first, size_type last) {
+			array<value_type> work(m_row_plan._work_size());
+			for (size_type row = first; row < last; ++row)
+				m_row_plan._execute(data + row*cols, data + row*cols, work.data(), inverse);
+		});
+
+		const size_type blocks = (cols + impl_fft::_column_block - 1) / impl_fft::_column_block;
+		const size_type block_grain = mtk::_max(impl_fft::_parallel_grain / (rows*impl_fft::_column_block), size_type(1));
+		mtk::_parallel_for(blocks, block_grain, [&](size_type first, size_type last) {
+			array<value_type> columns(rows*impl_fft::_column_block);
+			array<value_type> work(m_column_plan._work_size());
+			for (size_type block = first; block < last; ++block) {
+				const size_type col_first = block*impl_fft::_column_block;
+				const size_type count = mtk::_min(impl_fft::_column_block, cols - col_first);
+				for (size_type row = 0; row < rows; ++row) {
+					for (size_type i = 0; i < count; ++i)
+						columns[i*rows + row] = data[row*cols + col_first + i];
+				}
+
+				for (size_type i = 0; i < count; ++i)
+					m_column_plan._execute(columns.data() + i*rows, columns.data() + i*rows, work.data(), inverse);
+
+				for (size_type row = 0; row < rows; ++row) {
+					for (size_type i = 0; i < count; ++i)
+						data[row*cols + col_first + i] = columns[i*rows + row];
+				}
+			}
+		});
+	}
+
+private:
+	template<class Mat>
+	matrix_type
+	_load(const _matrix_base<Mat>& m) const
+	{
+		MTK_ASSERT(m.rows() == this->rows());
+		MTK_ASSERT(m.columns() == this->columns());
+
+		const size_type rows = m.rows();
+		const size_type cols = m.columns();
+		matrix_type ret(rows, cols);
+		for (size_type row = 0; row < rows; ++row) {
+			for (size_type col = 0; col < cols; ++col)
+				ret.value(row, col) = value_type(m.value(row, col));
+		}
+
+		return ret;
+	}
+
+	fft_plan<T> m_row_plan;
+	fft_plan<T> m_column_plan;
+};
+
+
+
+namespace impl_fft {
+
+template<class Vec>
+auto
+_transform(const _matrix_base<Vec>& v, bool inverse)
+{
+	using real_type = impl_matrix::_real_type_t<typename Vec::value_type>;
+	using value_type = std::complex<real_type>;
+	using ret_type = vector<value_type, dynamic_extent>;
+
+	MTK_ASSERT((v.rows() == 1) || (v.columns() == 1));
+
+	const size_t size = v.size();
+	ret_type ret(size);
+	size_t i = 0;
+	for (const auto& el : v)
+		ret.value(i++, 0) = value_type(el);
+
+	const fft_plan<real_type> plan(size);
+	array<value_type> work(plan._work_size());
+	plan._execute(ret.data(), ret.data(), work.data(), inverse);
+	return ret;
+}
+
+} // namespace impl_fft
+
+
+
+// One shot transforms of row or column vectors, build a plan to transform repeatedly.
+template<class Vec
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<impl_matrix::_real_type_t<typename Vec::value_type>>> = 0
+#endif
+>
+auto
+fft(const _matrix_base<Vec>& v)
+{
+	return impl_fft::_transform(v, false);
+}
+
+template<class Vec
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<impl_matrix::_real_type_t<typename Vec::value_type>>> = 0
+#endif
+>
+auto
+ifft(const _matrix_base<Vec>& v)
+{
+	return impl_fft::_transform(v, true);
+}
+
+template<class Vec
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<typename Vec::value_type>> = 0
+#endif
+>
+auto
+rfft(const _matrix_base<Vec>& v)
+{
+	using value_type = typename Vec::value_type;
+
+	MTK_ASSERT((v.rows() == 1) || (v.columns() == 1));
+
+	const real_fft_plan<value_type> plan(v.size());
+	array<value_type> in(v.begin(), v.end());
+	vector<std::complex<value_type>, dynamic_extent> ret(plan.spectrum_size());
+	plan.forward(in, span<std::complex<value_type>>(ret.data(), ret.size()));
+	return ret;
+}
+
+// size is the length of the original real sequence, either 2*(v.size() - 1) or one more.
+template<class Vec
+#ifndef MTK_DOXYGEN
+	,_require<impl_matrix::_is_complex<typename Vec::value_type>::value> = 0
+#endif
+>
+auto
+irfft(const _matrix_base<Vec>& v, size_t size)
+{
+	using real_type = impl_matrix::_real_type_t<typename Vec::value_type>;
+
+	MTK_ASSERT((v.rows() == 1) || (v.columns() == 1));
+
+	const real_fft_plan<real_type> plan(size);
+	array<typename Vec::value_type> in(v.begin(), v.end());
+	vector<real_type, dynamic_extent> ret(size);
+	plan.inverse(in, span<real_type>(ret.data(), ret.size()));
+	return ret;
+}
+
+template<class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<impl_matrix::_real_type_t<typename Mat::value_type>>> = 0
+#endif
+>
+auto
+fft2d(const _matrix_base<Mat>& m)
+{
+	return fft_plan2d<impl_matrix::_real_type_t<typename Mat::value_type>>(m.rows(), m.columns()).forward(m);
+}
+
+template<class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<impl_matrix::_real_type_t<typename Mat::value_type>>> = 0
+#endif
+>
+auto
+ifft2d(const _matrix_base<Mat>& m)
+{
+	return fft_plan2d<impl_matrix::_real_type_t<typename Mat::value_type>>(m.rows(), m.columns()).inverse(m);
+}
+
+} // namespace mtk
+
+#endif
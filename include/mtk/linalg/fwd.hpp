@@ -10,10 +10,19 @@ namespace mtk {
 enum class matrix_options
 {
 	row_major		= 0,
-	column_major	= (1 << 0)
+	column_major	= (1 << 0),
+	tiled			= (1 << 1)
 };
 MTK_DEFINE_FLAG_OPERATORS(matrix_options)
 
+enum class triangular_options
+{
+	lower			= 0,
+	upper			= (1 << 0),
+	unit_diagonal	= (1 << 1)
+};
+MTK_DEFINE_FLAG_OPERATORS(triangular_options)
+
 
 
 template<class Scalar
@@ -75,6 +84,56 @@ using row_vector3i = row_vector<int, 3>;
 using row_vector4i = row_vector<int, 4>;
 using row_vectorxi = row_vector<int, dynamic_extent>;
 
+
+
+template<class T>
+class quaternion;
+
+using quaternionf = quaternion<float>;
+using quaterniond = quaternion<double>;
+
+
+
+template<class T>
+class affine3;
+
+using affine3f = affine3<float>;
+using affine3d = affine3<double>;
+
+
+
+template<class Mat
+	,triangular_options Options>
+class triangular_view;
+
+template<class Scalar
+	,size_t Size = dynamic_extent>
+class diagonal_matrix;
+
+template<class Scalar>
+class banded_matrix;
+
+template<class Scalar
+	,size_t Size = dynamic_extent>
+class symmetric_matrix;
+
+
+
+template<class Scalar
+	,size_t... Extents>
+class tensor;
+
+
+
+template<class Scalar>
+class lu_decomposition;
+
+template<class Scalar>
+class qr_decomposition;
+
+template<class Scalar>
+class least_squares_accumulator;
+
 } // namespace mtk
 
 #endif
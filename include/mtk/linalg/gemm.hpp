@@ -0,0 +1,416 @@
+#ifndef MTK_LINALG_GEMM_HPP
+#define MTK_LINALG_GEMM_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/half.hpp>
+#include <mtk/core/preprocessor.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <complex>
+#include <type_traits>
+
+namespace mtk {
+
+template<class T>
+struct _linalg_accumulator
+{
+	using type = T;
+};
+
+template<>
+struct _linalg_accumulator<half>
+{
+	using type = float;
+};
+
+template<>
+struct _linalg_accumulator<bfloat16>
+{
+	using type = float;
+};
+
+template<>
+struct _linalg_accumulator<int8_t>
+{
+	using type = int32_t;
+};
+
+template<class T>
+using _linalg_accumulator_t = typename _linalg_accumulator<T>::type;
+
+
+
+namespace impl_gemm {
+
+inline constexpr
+size_t
+_depth_block = 256;
+
+template<class T
+	,class Acc>
+void
+_widen(const T* src, Acc* dst, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = static_cast<Acc>(src[i]);
+}
+
+inline
+void
+_widen(const half* src, float* dst, size_t n)
+{
+	mtk::convert(span<const half>(src, n), span<float>(dst, n));
+}
+
+inline
+void
+_widen(const bfloat16* src, float* dst, size_t n)
+{
+	mtk::convert(span<const bfloat16>(src, n), span<float>(dst, n));
+}
+
+void
+_gemm_s8(const int8_t* a, size_t lda, const int8_t* bt, size_t ldb, int32_t* c, size_t ldc, size_t m, size_t n, size_t k);
+
+void
+_gemv_s8(const int8_t* a, size_t lda, const int8_t* x, int32_t* y, size_t m, size_t k);
+
+
+
+// y += a*x, complex scalars use the vector kernels in gemm.cpp.
+template<class T>
+void
+_axpy(T a, const T* x, T* y, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		y[i] += impl_matrix::_mul(a, x[i]);
+}
+
+// Sum of x[i]*y[i] without conjugation.
+template<class T>
+T
+_dotu(const T* x, const T* y, size_t n)
+{
+	T sum = T();
+	for (size_t i = 0; i < n; ++i)
+		sum += impl_matrix::_mul(x[i], y[i]);
+
+	return sum;
+}
+
+void
+_axpy(std::complex<float> a, const std::complex<float>* x, std::complex<float>* y, size_t n);
+
+void
+_axpy(std::complex<double> a, const std::complex<double>* x, std::complex<double>* y, size_t n);
+
+std::complex<float>
+_dotu(const std::complex<float>* x, const std::complex<float>* y, size_t n);
+
+std::complex<double>
+_dotu(const std::complex<double>* x, const std::complex<double>* y, size_t n);
+
+
+
+inline constexpr
+size_t
+_column_block = 512;
+
+template<class T>
+void
+_gemm_kernel(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+	for (size_t i = 0; i < m; ++i) {
+		T* c_row = c + i*ldc;
+		for (size_t j = 0; j < n; ++j)
+			c_row[j] = T();
+	}
+
+	for (size_t k0 = 0; k0 < k; k0 += _depth_block) {
+		const size_t kn = mtk::_min(_depth_block, k - k0);
+		for (size_t j0 = 0; j0 < n; j0 += _column_block) {
+			const size_t jn = mtk::_min(_column_block, n - j0);
+			for (size_t i = 0; i < m; ++i) {
+				const T* a_row = a + i*lda + k0;
+				T* c_row = c + i*ldc + j0;
+				for (size_t p = 0; p < kn; ++p)
+					impl_gemm::_axpy(a_row[p], b + (k0 + p)*ldb + j0, c_row, jn);
+			}
+		}
+	}
+}
+
+template<class Mat>
+inline constexpr
+bool
+_has_contiguous_rows = std::is_pointer_v<typename Mat::const_iterator> && ((!Mat::_is_column_major && !Mat::_is_tiled) || (Mat::row_dimension == 1));
+
+template<class Mat>
+inline constexpr
+bool
+_has_contiguous_columns = std::is_pointer_v<typename Mat::const_iterator> && ((Mat::_is_column_major && !Mat::_is_tiled) || (Mat::column_dimension == 1));
+
+template<class Mat
+	,class Acc>
+void
+_widen_row(const _matrix_base<Mat>& m, size_t row, size_t first, size_t count, Acc* dst)
+{
+	if constexpr (_has_contiguous_rows<Mat>) {
+		impl_gemm::_widen(&m.value(row, first), dst, count);
+	} else {
+		for (size_t i = 0; i < count; ++i)
+			dst[i] = static_cast<Acc>(m.value(row, first + i));
+	}
+}
+
+template<class Mat
+	,class Acc>
+void
+_widen_vector(const _matrix_base<Mat>& v, Acc* dst)
+{
+	if constexpr (std::is_pointer_v<typename Mat::const_iterator>) {
+		impl_gemm::_widen(v.begin(), dst, v.size());
+	} else {
+		const auto sz = v.size();
+		for (size_t i = 0; i < sz; ++i)
+			dst[i] = static_cast<Acc>(v.value(i));
+	}
+}
+
+template<class Mat
+	,class T>
+const T*
+_packed_rows(const _matrix_base<Mat>& m, array<T>& buf)
+{
+	if constexpr (_has_contiguous_rows<Mat>) {
+		MTK_IGNORE(buf);
+		return m.begin();
+	} else {
+		const size_t rows = m.rows();
+		const size_t cols = m.columns();
+		buf = array<T>(rows*cols, for_overwrite);
+		for (size_t row = 0; row < rows; ++row) {
+			for (size_t col = 0; col < cols; ++col)
+				buf[row*cols + col] = m.value(row, col);
+		}
+		return buf.data();
+	}
+}
+
+template<class Mat
+	,class T>
+const T*
+_packed_columns(const _matrix_base<Mat>& m, array<T>& buf)
+{
+	if constexpr (_has_contiguous_columns<Mat>) {
+		MTK_IGNORE(buf);
+		return m.begin();
+	} else {
+		const size_t rows = m.rows();
+		const size_t cols = m.columns();
+		buf = array<T>(rows*cols, for_overwrite);
+		for (size_t col = 0; col < cols; ++col) {
+			for (size_t row = 0; row < rows; ++row)
+				buf[col*rows + row] = m.value(row, col);
+		}
+		return buf.data();
+	}
+}
+
+template<class MatA
+	,class MatB
+	,class MatC>
+void
+_gemm_s8(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs, _matrix_base<MatC>& ret)
+{
+	const size_t rows = lhs.rows();
+	const size_t cols = rhs.columns();
+	const size_t depth = lhs.columns();
+
+	array<int8_t> lhs_buf;
+	array<int8_t> rhs_buf;
+	const int8_t* a = impl_gemm::_packed_rows(lhs, lhs_buf);
+	const int8_t* bt = impl_gemm::_packed_columns(rhs, rhs_buf);
+	if constexpr (_has_contiguous_rows<MatC>) {
+		impl_gemm::_gemm_s8(a, depth, bt, depth, ret.begin(), cols, rows, cols, depth);
+	} else {
+		array<int32_t> out(rows*cols, for_overwrite);
+		impl_gemm::_gemm_s8(a, depth, bt, depth, out.data(), cols, rows, cols, depth);
+		for (size_t row = 0; row < rows; ++row) {
+			for (size_t col = 0; col < cols; ++col)
+				ret.value(row, col) = out[row*cols + col];
+		}
+	}
+}
+
+template<class MatA
+	,class MatB
+	,class MatC>
+void
+_gemm_widening(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs, _matrix_base<MatC>& ret)
+{
+	using acc_type = typename MatC::value_type;
+
+	const size_t rows = lhs.rows();
+	const size_t cols = rhs.columns();
+	const size_t depth = lhs.columns();
+
+	const size_t block = mtk::_min(_depth_block, depth);
+	array<acc_type> panel(block*cols, for_overwrite);
+	array<acc_type> lhs_row(block, for_overwrite);
+	array<acc_type> acc_row(_has_contiguous_rows<MatC> ? 0 : cols);
+
+	for (size_t k0 = 0; k0 < depth; k0 += block) {
+		const size_t kn = mtk::_min(block, depth - k0);
+		for (size_t k = 0; k < kn; ++k)
+			impl_gemm::_widen_row(rhs, k0 + k, 0, cols, panel.data() + k*cols);
+
+		for (size_t row = 0; row < rows; ++row) {
+			impl_gemm::_widen_row(lhs, row, k0, kn, lhs_row.data());
+
+			acc_type* out;
+			if constexpr (_has_contiguous_rows<MatC>) {
+				out = &ret.value(row, 0);
+			} else {
+				out = acc_row.data();
+				for (size_t col = 0; col < cols; ++col)
+					out[col] = acc_type();
+			}
+
+			for (size_t k = 0; k < kn; ++k)
+				impl_gemm::_axpy(lhs_row[k], panel.data() + k*cols, out, cols);
+
+			if constexpr (!_has_contiguous_rows<MatC>) {
+				for (size_t col = 0; col < cols; ++col)
+					ret.value(row, col) += out[col];
+			}
+		}
+	}
+}
+
+template<class Mat
+	,class Vec
+	,class Ret>
+void
+_gemv_widening(const _matrix_base<Mat>& mat, const _matrix_base<Vec>& vec, _matrix_base<Ret>& ret)
+{
+	using acc_type = typename Ret::value_type;
+
+	const size_t rows = mat.rows();
+	const size_t cols = mat.columns();
+
+	array<acc_type> x(cols, for_overwrite);
+	impl_gemm::_widen_vector(vec, x.data());
+
+	const size_t block = mtk::_min(_depth_block, cols);
+	array<acc_type> row_buf(block, for_overwrite);
+	for (size_t row = 0; row < rows; ++row) {
+		acc_type sum = acc_type();
+		for (size_t c0 = 0; c0 < cols; c0 += block) {
+			const size_t cn = mtk::_min(block, cols - c0);
+			impl_gemm::_widen_row(mat, row, c0, cn, row_buf.data());
+			sum += impl_gemm::_dotu(row_buf.data(), x.data() + c0, cn);
+		}
+		ret.value(row) = sum;
+	}
+}
+
+template<class Mat
+	,class Vec
+	,class Ret>
+void
+_gemv_s8(const _matrix_base<Mat>& mat, const _matrix_base<Vec>& vec, _matrix_base<Ret>& ret)
+{
+	const size_t rows = mat.rows();
+	const size_t cols = mat.columns();
+
+	array<int8_t> mat_buf;
+	array<int8_t> vec_buf;
+	const int8_t* a = impl_gemm::_packed_rows(mat, mat_buf);
+	const int8_t* x = impl_gemm::_packed_columns(vec, vec_buf);
+	impl_gemm::_gemv_s8(a, cols, x, ret.begin(), rows, cols);
+}
+
+} // namespace impl_gemm
+
+
+
+template<class MatA
+	,class MatB
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename MatA::value_type, typename MatB::value_type>> = 0
+	,_require<(MatA::column_dimension == MatB::row_dimension)> = 0
+#endif
+>
+auto
+gemm(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using value_type = typename MatA::value_type;
+	using acc_type = _linalg_accumulator_t<value_type>;
+	constexpr auto row_dim = MatA::row_dimension;
+	constexpr auto col_dim = MatB::column_dimension;
+	constexpr auto opt = MatA::options | MatB::options;
+	using ret_type1 = typename _linalg_traits<MatA>::template matrix_type<acc_type, row_dim, col_dim, opt>;
+	using ret_type2 = typename _linalg_traits<MatB>::template matrix_type<acc_type, row_dim, col_dim, opt>;
+	using mat_type = matrix<acc_type, row_dim, col_dim, opt>;
+	using ret_type = std::conditional_t<std::is_same_v<ret_type1, mat_type>, ret_type2, ret_type1>;
+
+	// The int8 kernel writes every element, the widening one accumulates into zeros.
+	if constexpr (std::is_same_v<value_type, int8_t>) {
+		auto ret = mtk::_make_matrix_for_overwrite<ret_type>(lhs.rows(), rhs.columns());
+		if (!ret.empty())
+			impl_gemm::_gemm_s8(lhs, rhs, ret);
+		return ret;
+	} else {
+		auto ret = mtk::_make_matrix<ret_type>(lhs.rows(), rhs.columns());
+		if (!ret.empty())
+			impl_gemm::_gemm_widening(lhs, rhs, ret);
+		return ret;
+	}
+}
+
+template<class Mat
+	,class Vec
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename Mat::value_type, typename Vec::value_type>> = 0
+	,_require<(Mat::column_dimension == Vec::row_dimension)> = 0
+	,_require<(Vec::column_dimension == 1)> = 0
+#endif
+>
+auto
+gemv(const _matrix_base<Mat>& mat, const _matrix_base<Vec>& vec)
+{
+	MTK_ASSERT(mat.columns() == vec.rows());
+
+	using value_type = typename Mat::value_type;
+	using acc_type = _linalg_accumulator_t<value_type>;
+	constexpr auto row_dim = Mat::row_dimension;
+	constexpr auto opt = Mat::options | Vec::options;
+	using ret_type1 = typename _linalg_traits<Mat>::template matrix_type<acc_type, row_dim, 1, opt>;
+	using ret_type2 = typename _linalg_traits<Vec>::template matrix_type<acc_type, row_dim, 1, opt>;
+	using mat_type = matrix<acc_type, row_dim, 1, opt>;
+	using ret_type = std::conditional_t<std::is_same_v<ret_type1, mat_type>, ret_type2, ret_type1>;
+
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(mat.rows(), 1);
+	if (ret.empty())
+		return ret;
+
+	if constexpr (std::is_same_v<value_type, int8_t>)
+		impl_gemm::_gemv_s8(mat, vec, ret);
+	else
+		impl_gemm::_gemv_widening(mat, vec, ret);
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef MTK_LINALG_LEAST_SQUARES_HPP
+#define MTK_LINALG_LEAST_SQUARES_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/move.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace mtk {
+
+// Least squares over rows streamed in one batch at a time, only the R factor of the
+// design matrix augmented with the targets is kept, (columns() + 1)^2 values in total.
+// Rows are folded in with Givens rotations, which is as stable as a QR of the whole matrix.
+// Accumulators fed from different threads can be combined with merge().
+template<class Scalar>
+class least_squares_accumulator
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using real_type = impl_matrix::_real_type_t<Scalar>;
+	using vector_type = matrix<Scalar, dynamic_extent, 1>;
+	using matrix_type = matrix<Scalar, dynamic_extent, dynamic_extent>;
+
+	least_squares_accumulator() :
+		least_squares_accumulator(0)
+	{ }
+
+	explicit
+	least_squares_accumulator(size_type columns) :
+		m_r((columns + 1)*(columns + 1)),
+		m_row(columns + 1),
+		m_cols(columns),
+		m_rows()
+	{ }
+
+	size_type
+	columns() const noexcept
+	{
+		return m_cols;
+	}
+
+	// Number of rows added so far.
+	size_type
+	rows() const noexcept
+	{
+		return m_rows;
+	}
+
+	void
+	clear()
+	{
+		for (auto& val : m_r)
+			val = value_type();
+		m_rows = 0;
+	}
+
+	void
+	add_row(span<const Scalar> x, Scalar y)
+	{
+		MTK_ASSERT(x.size() == m_cols);
+
+		for (size_type col = 0; col < m_cols; ++col)
+			m_row[col] = x[col];
+		m_row[m_cols] = y;
+		this->_fold(0);
+		++m_rows;
+	}
+
+	template<class Vec
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Vec::value_type, Scalar>> = 0
+#endif
+	>
+	void
+	add_row(const _matrix_base<Vec>& x, Scalar y)
+	{
+		MTK_ASSERT(x.size() == m_cols);
+
+		size_type col = 0;
+		for (const auto& val : x)
+			m_row[col++] = val;
+		m_row[m_cols] = y;
+		this->_fold(0);
+		++m_rows;
+	}
+
+	// x holds y.size() rows of columns() values each, row major.
+	void
+	add_rows(span<const Scalar> x, span<const Scalar> y)
+	{
+		MTK_ASSERT(x.size() == y.size()*m_cols);
+
+		for (size_type row = 0; row < y.size(); ++row)
+			this->add_row(span<const Scalar>(x.data() + row*m_cols, m_cols), y[row]);
+	}
+
+	template<class Mat
+		,class Vec
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+		,_require<std::is_same_v<typename Vec::value_type, Scalar>> = 0
+#endif
+	>
+	void
+	add_rows(const _matrix_base<Mat>& x, const _matrix_base<Vec>& y)
+	{
+		MTK_ASSERT(x.columns() == m_cols);
+		MTK_ASSERT((y.size() == x.rows()) && ((y.rows() == 1) || (y.columns() == 1)));
+
+		const size_type rows = x.rows();
+		auto target = y.begin();
+		for (size_type row = 0; row < rows; ++row, ++target) {
+			for (size_type col = 0; col < m_cols; ++col)
+				m_row[col] = x.value(row, col);
+			m_row[m_cols] = *target;
+			this->_fold(0);
+		}
+
+		m_rows += rows;
+	}
+
+	// Afterwards *this describes the rows of both accumulators.
+	void
+	merge(const least_squares_accumulator& other)
+	{
+		MTK_ASSERT(other.m_cols == m_cols);
+
+		const size_type n = m_cols + 1;
+		for (size_type row = 0; row < n; ++row) {
+			const value_type* src = other.m_r.data() + row*n;
+			for (size_type col = 0; col < n; ++col)
+				m_row[col] = (col < row ? value_type() : src[col]);
+			this->_fold(row);
+		}
+
+		m_rows += other.m_rows;
+	}
+
+	// Upper triangular columns() x columns() factor, A^H*A == R^H*R.
+	matrix_type
+	r() const
+	{
+		const size_type n = m_cols + 1;
+		matrix_type ret(m_cols, m_cols);
+		for (size_type row = 0; row < m_cols; ++row) {
+			for (size_type col = row; col < m_cols; ++col)
+				ret.value(row, col) = m_r[row*n + col];
+		}
+
+		return ret;
+	}
+
+	// |A*x - y| at the least squares solution.
+	real_type
+	residual_norm() const
+	{
+		const size_type n = m_cols + 1;
+		return std::abs(m_r[n*n - 1]);
+	}
+
+	// Minimizes |A*x - y| over the rows added so far, empty if A does not have full column rank.
+	// The rank is numerical, a diagonal entry of R at most columns()*eps*max|R_jj| counts as zero.
+	std::optional<vector_type>
+	solve() const
+	{
+		const size_type n = m_cols + 1;
+		real_type max_diag = real_type();
+		for (size_type i = 0; i < m_cols; ++i)
+			max_diag = mtk::_max(max_diag, real_type(std::abs(m_r[i*n + i])));
+
+		const real_type tolerance = real_type(m_cols)*std::numeric_limits<real_type>::epsilon()*max_diag;
+		for (size_type i = 0; i < m_cols; ++i) {
+			if (!(std::abs(m_r[i*n + i]) > tolerance))
+				return std::optional<vector_type>();
+		}
+
+		vector_type ret(m_cols);
+		for (size_type i = 0; i < m_cols; ++i) {
+			const size_type row = m_cols - 1 - i;
+			value_type sum = m_r[row*n + m_cols];
+			for (size_type col = row + 1; col < m_cols; ++col)
+				sum -= impl_matrix::_mul(m_r[row*n + col], ret.value(col, 0));
+			ret.value(row, 0) = sum / m_r[row*n + row];
+		}
+
+		return std::optional<vector_type>(mtk::_move(ret));
+	}
+
+private:
+	// Rotates m_row into rows first, first + 1, ... of m_r, m_row must be zero before index first.
+	void
+	_fold(size_type first)
+	{
+		const size_type n = m_cols + 1;
+		value_type* x = m_row.data();
+		for (size_type k = first; k < n; ++k) {
+			const value_type b = x[k];
+			if (b == value_type())
+				continue;
+
+			value_type* r = m_r.data() + k*n;
+			const value_type a = r[k];
+			const real_type abs_a = std::abs(a);
+			const real_type abs_b = std::abs(b);
+			const real_type norm = std::hypot(abs_a, abs_b);
+
+			// [c s; -conj(s) c] with c real, zeroes x[k] against r[k].
+			real_type c;
+			value_type s;
+			if (abs_a == real_type()) {
+				c = real_type();
+				s = impl_matrix::_conj(b) / abs_b;
+			} else {
+				c = abs_a / norm;
+				s = impl_matrix::_mul(a / abs_a, impl_matrix::_conj(b)) / norm;
+			}
+
+			const value_type neg_conj_s = -impl_matrix::_conj(s);
+			for (size_type col = k; col < n; ++col) {
+				const value_type rv = r[col];
+				r[col] = c*rv + impl_matrix::_mul(s, x[col]);
+				x[col] = impl_matrix::_mul(neg_conj_s, rv) + c*x[col];
+			}
+		}
+	}
+
+	array<value_type> m_r;
+	array<value_type> m_row;
+	size_type m_cols;
+	size_type m_rows;
+};
+
+} // namespace mtk
+
+#endif
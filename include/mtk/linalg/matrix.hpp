@@ -4,8 +4,11 @@
 #include <mtk/core/array.hpp>
 #include <mtk/core/assert.hpp>
 #include <mtk/core/iterator_traits.hpp>
+#include <mtk/core/memory_placement.hpp>
+#include <mtk/core/memory_resource.hpp>
 #include <mtk/core/preprocessor.hpp>
 #include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
 #include <mtk/core/impl/declval.hpp>
 #include <mtk/core/impl/move.hpp>
 #include <mtk/core/impl/require.hpp>
@@ -14,11 +17,13 @@
 #include <mtk/linalg/fwd.hpp>
 
 #include <cmath>
+#include <complex>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <optional>
 #include <type_traits>
+#include <utility>
 
 namespace mtk {
 
@@ -39,6 +44,10 @@ class _vector_reference;
 template<class Iter>
 class _matrix_stride_iterator;
 
+template<class Iter
+	,bool IsColumnMajor>
+class _matrix_tile_iterator;
+
 template<class Iter
 	,class ConstIter
 	,size_t R
@@ -54,6 +63,246 @@ template<class T
 	,class... Args>
 inline constexpr bool _fold_is_convertible_to = (std::is_convertible_v<Args, T> && ...);
 
+
+
+// Tiled storage splits the matrix into _tile_size square tiles stored one after another,
+// the tiles at the bottom and right edges are cropped so no padding is needed.
+// Vectors are never tiled since their tiled and linear layouts coincide.
+inline constexpr size_t _tile_size = 8;
+
+template<size_t R
+	,size_t C
+	,matrix_options Opt>
+inline constexpr bool _is_tiled = ((Opt & matrix_options::tiled) == matrix_options::tiled) && (R != 1) && (C != 1);
+
+template<matrix_options Opt>
+inline constexpr bool _is_row_major_storage = ((Opt & (matrix_options::column_major | matrix_options::tiled)) == matrix_options::row_major);
+
+template<bool IsColumnMajor>
+constexpr
+size_t
+_tiled_offset(size_t rows, size_t cols, size_t row, size_t col)
+{
+	const size_t tile_row = row / _tile_size;
+	const size_t tile_col = col / _tile_size;
+	const size_t height = (rows - tile_row*_tile_size < _tile_size ? rows - tile_row*_tile_size : _tile_size);
+	const size_t width = (cols - tile_col*_tile_size < _tile_size ? cols - tile_col*_tile_size : _tile_size);
+	if constexpr (IsColumnMajor)
+		return tile_col*_tile_size*rows + tile_row*_tile_size*width + (col % _tile_size)*height + row % _tile_size;
+	else
+		return tile_row*_tile_size*cols + tile_col*_tile_size*height + (row % _tile_size)*width + col % _tile_size;
+}
+
+// Moves the kept rows [first, keep_rows) and columns [0, keep_cols) of a tiled layout from rows x cols
+// to new_rows x new_cols in place, first must be a multiple of the tile size. Tiles keep their storage order
+// when the extents change, so visiting them back to front when growing and front to back when shrinking
+// never overwrites a pending element. A tile whose extents do not change moves as one block.
+template<bool IsColumnMajor
+	,bool Reverse
+	,class T>
+void
+_move_tiled(T* data, size_t first, size_t keep_rows, size_t keep_cols, size_t rows, size_t cols, size_t new_rows, size_t new_cols)
+{
+	// Lines are the rows of a row major tile and the columns of a column major one.
+	const size_t line_first = (IsColumnMajor ? 0 : first);
+	const size_t line_last = (IsColumnMajor ? keep_cols : keep_rows);
+	const size_t elem_first = (IsColumnMajor ? first : 0);
+	const size_t elem_last = (IsColumnMajor ? keep_rows : keep_cols);
+	const size_t line_extent = (IsColumnMajor ? cols : rows);
+	const size_t new_line_extent = (IsColumnMajor ? new_cols : new_rows);
+	const size_t elem_extent = (IsColumnMajor ? rows : cols);
+	const size_t new_elem_extent = (IsColumnMajor ? new_rows : new_cols);
+	const size_t line_tiles = (line_last - line_first + _tile_size - 1) / _tile_size;
+	const size_t elem_tiles = (elem_last - elem_first + _tile_size - 1) / _tile_size;
+	const auto index = [](size_t i, size_t count) {
+		return (Reverse ? count - 1 - i : i);
+	};
+	const auto move = [&](size_t src, size_t dst) {
+		if (src != dst)
+			data[dst] = mtk::_move(data[src]);
+	};
+
+	for (size_t a = 0; a < line_tiles; ++a) {
+		const size_t line_tile = line_first + index(a, line_tiles)*_tile_size;
+		const size_t lines = mtk::_min(line_last - line_tile, _tile_size);
+		const bool same_lines = (mtk::_min(line_extent - line_tile, _tile_size) == mtk::_min(new_line_extent - line_tile, _tile_size));
+		for (size_t b = 0; b < elem_tiles; ++b) {
+			const size_t elem_tile = elem_first + index(b, elem_tiles)*_tile_size;
+			const size_t elems = mtk::_min(elem_last - elem_tile, _tile_size);
+			const size_t stride = mtk::_min(elem_extent - elem_tile, _tile_size);
+			const size_t new_stride = mtk::_min(new_elem_extent - elem_tile, _tile_size);
+			const size_t row = (IsColumnMajor ? elem_tile : line_tile);
+			const size_t col = (IsColumnMajor ? line_tile : elem_tile);
+			const size_t src = impl_matrix::_tiled_offset<IsColumnMajor>(rows, cols, row, col);
+			const size_t dst = impl_matrix::_tiled_offset<IsColumnMajor>(new_rows, new_cols, row, col);
+
+			if (same_lines && (stride == new_stride)) {
+				const size_t count = lines*elems;
+				for (size_t i = 0; i < count; ++i)
+					move(src + index(i, count), dst + index(i, count));
+			} else {
+				for (size_t c = 0; c < lines; ++c) {
+					const size_t line = index(c, lines);
+					for (size_t d = 0; d < elems; ++d) {
+						const size_t elem = index(d, elems);
+						move(src + line*stride + elem, dst + line*new_stride + elem);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Relayouts the rows x cols elements at the front of data as new_rows x new_cols, keeping the overlap
+// and value initializing the rest. data only reallocates when it holds fewer than the new size or capacity
+// elements, otherwise the elements are moved in place. Tiled storage also reallocates when one extent grows
+// while the other shrinks.
+template<bool IsColumnMajor
+	,bool IsTiled
+	,class T>
+void
+_resize_storage(array<T, dynamic_extent>& data, size_t rows, size_t cols, size_t new_rows, size_t new_cols, size_t capacity)
+{
+	const size_t new_size = new_rows*new_cols;
+	const size_t keep_rows = (rows < new_rows ? rows : new_rows);
+	const size_t keep_cols = (cols < new_cols ? cols : new_cols);
+
+	if constexpr (IsTiled) {
+		const bool grows = (new_rows >= rows) && (new_cols >= cols);
+		const bool shrinks = (new_rows <= rows) && (new_cols <= cols);
+		if ((grows || shrinks) && (new_size <= data.size()) && (capacity <= data.size())) {
+			// Row major tile rows before the last kept one do not move while the columns stay.
+			const size_t first = (!IsColumnMajor && (new_cols == cols) ? keep_rows / _tile_size*_tile_size : 0);
+			if (grows)
+				impl_matrix::_move_tiled<IsColumnMajor, true>(data.data(), first, keep_rows, keep_cols, rows, cols, new_rows, new_cols);
+			else
+				impl_matrix::_move_tiled<IsColumnMajor, false>(data.data(), first, keep_rows, keep_cols, rows, cols, new_rows, new_cols);
+
+			const auto clear = [&](size_t row, size_t col) {
+				data[impl_matrix::_tiled_offset<IsColumnMajor>(new_rows, new_cols, row, col)] = T();
+			};
+
+			for (size_t row = 0; (row < keep_rows) && (keep_cols < new_cols); ++row) {
+				for (size_t col = keep_cols; col < new_cols; ++col)
+					clear(row, col);
+			}
+
+			for (size_t row = keep_rows; row < new_rows; ++row) {
+				for (size_t col = 0; col < new_cols; ++col)
+					clear(row, col);
+			}
+
+			return;
+		}
+
+		const size_t size = mtk::_max(mtk::_max(new_size, capacity), data.size());
+		array<T, dynamic_extent> tmp(size, *data.resource());
+		for (size_t row = 0; row < keep_rows; ++row) {
+			for (size_t col = 0; col < keep_cols; ++col) {
+				const size_t src = impl_matrix::_tiled_offset<IsColumnMajor>(rows, cols, row, col);
+				const size_t dst = impl_matrix::_tiled_offset<IsColumnMajor>(new_rows, new_cols, row, col);
+				tmp[dst] = mtk::_move(data[src]);
+			}
+		}
+
+		data.swap(tmp);
+		return;
+	}
+
+	// Outer runs over the contiguous lines, rows for row major and columns for column major.
+	const size_t outer = (IsColumnMajor ? keep_cols : keep_rows);
+	const size_t inner = (IsColumnMajor ? rows : cols);
+	const size_t new_inner = (IsColumnMajor ? new_rows : new_cols);
+	const size_t keep_inner = (IsColumnMajor ? keep_rows : keep_cols);
+
+	if ((new_size > data.size()) || (capacity > data.size())) {
+		array<T, dynamic_extent> tmp(new_size > capacity ? new_size : capacity, *data.resource());
+		for (size_t o = 0; o < outer; ++o) {
+			for (size_t i = 0; i < keep_inner; ++i)
+				tmp[o*new_inner + i] = mtk::_move(data[o*inner + i]);
+		}
+
+		data.swap(tmp);
+		return;
+	}
+
+	if (new_inner < inner) {
+		for (size_t o = 1; o < outer; ++o) {
+			for (size_t i = 0; i < keep_inner; ++i)
+				data[o*new_inner + i] = mtk::_move(data[o*inner + i]);
+		}
+	} else if (new_inner > inner) {
+		for (size_t o = outer; o-- > 1;) {
+			for (size_t i = keep_inner; i-- > 0;)
+				data[o*new_inner + i] = mtk::_move(data[o*inner + i]);
+		}
+
+		for (size_t o = 0; o < outer; ++o) {
+			for (size_t i = keep_inner; i < new_inner; ++i)
+				data[o*new_inner + i] = T();
+		}
+	}
+
+	for (size_t i = outer*new_inner; i < new_size; ++i)
+		data[i] = T();
+}
+
+template<class T>
+struct _is_complex :
+	std::false_type
+{ };
+
+template<class T>
+struct _is_complex<std::complex<T>> :
+	std::true_type
+{ };
+
+template<class T>
+struct _real_type
+{
+	using type = T;
+};
+
+template<class T>
+struct _real_type<std::complex<T>>
+{
+	using type = T;
+};
+
+template<class T>
+using _real_type_t = typename _real_type<T>::type;
+
+template<class T>
+constexpr
+T
+_conj(const T& val)
+{
+	if constexpr (_is_complex<T>::value)
+		return T(val.real(), -val.imag());
+	else
+		return val;
+}
+
+// std::complex multiplication goes through the nan checking library call, this does not.
+template<class T>
+constexpr
+T
+_mul(const T& lhs, const T& rhs)
+{
+	if constexpr (_is_complex<T>::value)
+		return T(lhs.real()*rhs.real() - lhs.imag()*rhs.imag(), lhs.real()*rhs.imag() + lhs.imag()*rhs.real());
+	else
+		return lhs*rhs;
+}
+
+template<class Iter
+	,size_t R
+	,size_t C
+	,matrix_options Opt>
+using _matrix_element_iterator = std::conditional_t<_is_tiled<R, C, Opt>,
+	_matrix_tile_iterator<Iter, ((Opt & matrix_options::column_major) == matrix_options::column_major)>,
+	_matrix_stride_iterator<Iter>>;
+
 } // namespace impl_matrix
 
 
@@ -88,12 +337,13 @@ struct _linalg_traits<matrix<S, R, C, Opt>>
 		return m.m_data.begin();
 	}
 
+	// Dynamic matrices may hold spare capacity after the elements.
 	template<class Mat>
 	static constexpr
 	auto
 	end(Mat&& m)
 	{
-		return m.m_data.end();
+		return m.m_data.begin() + rows(m)*columns(m);
 	}
 
 	static constexpr
@@ -215,6 +465,25 @@ _make_matrix(size_t rows, size_t cols)
 		return Mat();
 }
 
+// As _make_matrix, but dynamic storage is left uninitialized for results that write every element.
+template<class Mat>
+constexpr
+Mat
+_make_matrix_for_overwrite(size_t rows, size_t cols)
+{
+	MTK_IGNORE(rows, cols);
+	constexpr auto row_dim = std::decay_t<Mat>::row_dimension;
+	constexpr auto col_dim = std::decay_t<Mat>::column_dimension;
+	if constexpr ((row_dim == dynamic_extent) && (col_dim == dynamic_extent))
+		return Mat(rows, cols, for_overwrite);
+	else if constexpr (row_dim == dynamic_extent)
+		return Mat(rows, for_overwrite);
+	else if constexpr (col_dim == dynamic_extent)
+		return Mat(cols, for_overwrite);
+	else
+		return Mat();
+}
+
 
 template<class Derived>
 class _matrix_base
@@ -270,6 +539,10 @@ public:
 	bool
 	_is_vector = ((row_dimension == 1) || (column_dimension == 1));
 
+	static constexpr
+	bool
+	_is_tiled = impl_matrix::_is_tiled<row_dimension, column_dimension, options>;
+
 
 
 	constexpr
@@ -652,7 +925,9 @@ public:
 	{
 		MTK_ASSERT(row < this->rows());
 		MTK_ASSERT(column < this->columns());
-		if constexpr (_is_column_major) {
+		if constexpr (_is_tiled) {
+			return *(this->begin() + impl_matrix::_tiled_offset<_is_column_major>(this->rows(), this->columns(), row, column));
+		} else if constexpr (_is_column_major) {
 			return *(this->begin() + row + column*this->rows());
 		} else {
 			return *(this->begin() + row*this->columns() + column);
@@ -665,7 +940,9 @@ public:
 	{
 		MTK_ASSERT(row < this->rows());
 		MTK_ASSERT(column < this->columns());
-		if constexpr (_is_column_major) {
+		if constexpr (_is_tiled) {
+			return *(this->begin() + impl_matrix::_tiled_offset<_is_column_major>(this->rows(), this->columns(), row, column));
+		} else if constexpr (_is_column_major) {
 			return *(this->begin() + row + column*this->rows());
 		} else {
 			return *(this->begin() + row*this->columns() + column);
@@ -764,7 +1041,7 @@ public:
 
 		const auto rs = this->rows();
 		const auto cs = this->columns();
-		auto ret = mtk::_make_matrix<ret_type>(cs, rs);
+		auto ret = mtk::_make_matrix_for_overwrite<ret_type>(cs, rs);
 		for (size_type r = 0; r < rs; ++r) {
 			for (size_type c = 0; c < cs; ++c) {
 				ret.value(c, r) = this->value(r, c);
@@ -774,6 +1051,43 @@ public:
 		return ret;
 	}
 
+	constexpr
+	auto
+	conjugated() const
+	{
+		using ret_type = typename _linalg_traits<Derived>::template matrix_type<value_type, row_dimension, column_dimension, options>;
+
+		const auto rs = this->rows();
+		const auto cs = this->columns();
+		auto ret = mtk::_make_matrix_for_overwrite<ret_type>(rs, cs);
+		for (size_type r = 0; r < rs; ++r) {
+			for (size_type c = 0; c < cs; ++c) {
+				ret.value(r, c) = impl_matrix::_conj(this->value(r, c));
+			}
+		}
+
+		return ret;
+	}
+
+	// Conjugate transpose, the same as transposed() for real scalars.
+	constexpr
+	auto
+	hermitian_transposed() const
+	{
+		using ret_type = typename _linalg_traits<Derived>::template matrix_type<value_type, column_dimension, row_dimension, options>;
+
+		const auto rs = this->rows();
+		const auto cs = this->columns();
+		auto ret = mtk::_make_matrix_for_overwrite<ret_type>(cs, rs);
+		for (size_type r = 0; r < rs; ++r) {
+			for (size_type c = 0; c < cs; ++c) {
+				ret.value(c, r) = impl_matrix::_conj(this->value(r, c));
+			}
+		}
+
+		return ret;
+	}
+
 
 
 #ifndef MTK_DOXYGEN
@@ -902,13 +1216,17 @@ public:
 	using Base::row_dimension;
 	using Base::options;
 	using Base::_is_column_major;
+	using Base::_is_tiled;
 
 	static constexpr
 	size_type
 	dimension = row_dimension;
 
-	using diagonal_vector_type = impl_matrix::_vector_reference<impl_matrix::_matrix_stride_iterator<iterator>, impl_matrix::_matrix_stride_iterator<const_iterator>, dimension, 1, options>;
-	using const_diagonal_vector_type = impl_matrix::_vector_reference<impl_matrix::_matrix_stride_iterator<const_iterator>, impl_matrix::_matrix_stride_iterator<const_iterator>, dimension, 1, options>;
+	using _diagonal_iterator = impl_matrix::_matrix_element_iterator<iterator, dimension, dimension, options>;
+	using _const_diagonal_iterator = impl_matrix::_matrix_element_iterator<const_iterator, dimension, dimension, options>;
+
+	using diagonal_vector_type = impl_matrix::_vector_reference<_diagonal_iterator, _const_diagonal_iterator, dimension, 1, options>;
+	using const_diagonal_vector_type = impl_matrix::_vector_reference<_const_diagonal_iterator, _const_diagonal_iterator, dimension, 1, options>;
 
 
 	constexpr
@@ -922,16 +1240,26 @@ public:
 	diagonal_vector_type
 	diagonal()
 	{
-		auto it = impl_matrix::_matrix_stride_iterator<iterator>(this->begin(), this->order() + 1, 0);
-		return diagonal_vector_type(it, this->order());
+		if constexpr (_is_tiled) {
+			auto it = _diagonal_iterator(this->begin(), this->order(), this->order(), 0, 0, 1, 1, 0);
+			return diagonal_vector_type(it, this->order());
+		} else {
+			auto it = _diagonal_iterator(this->begin(), this->order() + 1, 0);
+			return diagonal_vector_type(it, this->order());
+		}
 	}
 
 	constexpr
 	const_diagonal_vector_type
 	diagonal() const
 	{
-		auto it = impl_matrix::_matrix_stride_iterator<const_iterator>(this->begin(), this->order() + 1, 0);
-		return const_diagonal_vector_type(it, this->order());
+		if constexpr (_is_tiled) {
+			auto it = _const_diagonal_iterator(this->begin(), this->order(), this->order(), 0, 0, 1, 1, 0);
+			return const_diagonal_vector_type(it, this->order());
+		} else {
+			auto it = _const_diagonal_iterator(this->begin(), this->order() + 1, 0);
+			return const_diagonal_vector_type(it, this->order());
+		}
 	}
 
 	constexpr
@@ -1004,6 +1332,265 @@ public:
 
 
 
+namespace impl_matrix {
+
+template<class T
+	,size_t N>
+struct _lu_decomposition
+{
+	T lu[N][N] = { };
+	size_t perm[N] = { };
+	T det = T(1);
+	// Pivots at or below tolerance make the matrix numerically singular.
+	_real_type_t<T> tolerance = _real_type_t<T>();
+	bool singular = false;
+};
+
+// Complex pivots are ranked by |re| + |im| like LAPACK, which avoids the square root.
+template<class T>
+constexpr
+_real_type_t<T>
+_lu_abs(T val)
+{
+	if constexpr (_is_complex<T>::value)
+		return impl_matrix::_lu_abs(val.real()) + impl_matrix::_lu_abs(val.imag());
+	else
+		return (val < T() ? -val : val);
+}
+
+template<class T
+	,class U>
+constexpr
+T
+_lu_cast(U val)
+{
+	if constexpr (std::is_integral_v<T> && std::is_floating_point_v<U>)
+		return static_cast<T>(val < U() ? val - U(0.5) : val + U(0.5));
+	else
+		return static_cast<T>(val);
+}
+
+template<class T
+	,size_t N
+	,class Mat
+	,size_t... Is>
+constexpr
+void
+_lu_load(_lu_decomposition<T, N>& d, const Mat& m, std::index_sequence<Is...>)
+{
+	((d.lu[Is / N][Is % N] = static_cast<T>(m.value(Is / N, Is % N))), ...);
+
+	_real_type_t<T> scale = _real_type_t<T>();
+	((scale = mtk::_max(scale, impl_matrix::_lu_abs(d.lu[Is / N][Is % N]))), ...);
+	d.tolerance = static_cast<_real_type_t<T>>(N)*std::numeric_limits<_real_type_t<T>>::epsilon()*scale;
+}
+
+template<size_t N
+	,size_t... Is>
+constexpr
+void
+_lu_identity(size_t (&perm)[N], std::index_sequence<Is...>)
+{
+	((perm[Is] = Is), ...);
+}
+
+template<size_t K
+	,size_t I
+	,class T
+	,size_t N>
+constexpr
+void
+_lu_update_pivot(const T (&lu)[N][N], size_t& pivot, _real_type_t<T>& pivot_abs)
+{
+	const _real_type_t<T> val = impl_matrix::_lu_abs(lu[I][K]);
+	if (val > pivot_abs) {
+		pivot = I;
+		pivot_abs = val;
+	}
+}
+
+template<class T
+	,size_t N
+	,size_t... Js>
+constexpr
+void
+_lu_swap_rows(T (&lu)[N][N], size_t a, size_t b, std::index_sequence<Js...>)
+{
+	(mtk::_swap(lu[a][Js], lu[b][Js]), ...);
+}
+
+template<size_t K
+	,class T
+	,size_t N
+	,size_t... Is>
+constexpr
+void
+_lu_pivot(_lu_decomposition<T, N>& d, std::index_sequence<Is...>)
+{
+	size_t pivot = K;
+	_real_type_t<T> pivot_abs = impl_matrix::_lu_abs(d.lu[K][K]);
+	(impl_matrix::_lu_update_pivot<K, K + 1 + Is>(d.lu, pivot, pivot_abs), ...);
+	if (pivot != K) {
+		impl_matrix::_lu_swap_rows(d.lu, K, pivot, std::make_index_sequence<N>());
+		mtk::_swap(d.perm[K], d.perm[pivot]);
+		d.det = -d.det;
+	}
+}
+
+template<size_t K
+	,size_t I
+	,class T
+	,size_t N
+	,size_t... Js>
+constexpr
+void
+_lu_eliminate_row(T (&lu)[N][N], std::index_sequence<Js...>)
+{
+	const T factor = lu[I][K] / lu[K][K];
+	lu[I][K] = factor;
+	((lu[I][K + 1 + Js] -= factor*lu[K][K + 1 + Js]), ...);
+}
+
+template<size_t K
+	,class T
+	,size_t N
+	,size_t... Is>
+constexpr
+void
+_lu_eliminate(T (&lu)[N][N], std::index_sequence<Is...>)
+{
+	(impl_matrix::_lu_eliminate_row<K, K + 1 + Is>(lu, std::make_index_sequence<N - K - 1>()), ...);
+}
+
+template<size_t K
+	,class T
+	,size_t N>
+constexpr
+void
+_lu_factor(_lu_decomposition<T, N>& d)
+{
+	if constexpr (K < N) {
+		if constexpr (K + 1 < N)
+			impl_matrix::_lu_pivot<K>(d, std::make_index_sequence<N - K - 1>());
+
+		d.det *= d.lu[K][K];
+		if (impl_matrix::_lu_abs(d.lu[K][K]) <= d.tolerance)
+			d.singular = true;
+
+		if (d.lu[K][K] == T())
+			return;
+
+		impl_matrix::_lu_eliminate<K>(d.lu, std::make_index_sequence<N - K - 1>());
+		impl_matrix::_lu_factor<K + 1>(d);
+	}
+}
+
+template<class T
+	,size_t N
+	,class Mat>
+constexpr
+_lu_decomposition<T, N>
+_lu_decompose(const Mat& m)
+{
+	_lu_decomposition<T, N> d;
+	impl_matrix::_lu_load(d, m, std::make_index_sequence<N*N>());
+	impl_matrix::_lu_identity(d.perm, std::make_index_sequence<N>());
+	impl_matrix::_lu_factor<0>(d);
+	return d;
+}
+
+template<size_t I
+	,class T
+	,size_t N
+	,size_t... Js>
+constexpr
+void
+_lu_forward_row(const T (&lu)[N][N], T (&x)[N], std::index_sequence<Js...>)
+{
+	((x[I] -= lu[I][Js]*x[Js]), ...);
+}
+
+template<size_t I
+	,class T
+	,size_t N
+	,size_t... Js>
+constexpr
+void
+_lu_backward_row(const T (&lu)[N][N], T (&x)[N], std::index_sequence<Js...>)
+{
+	((x[I] -= lu[I][I + 1 + Js]*x[I + 1 + Js]), ...);
+	x[I] /= lu[I][I];
+}
+
+template<class T
+	,size_t N
+	,size_t... Is>
+constexpr
+void
+_lu_substitute(const T (&lu)[N][N], T (&x)[N], std::index_sequence<Is...>)
+{
+	(impl_matrix::_lu_forward_row<Is>(lu, x, std::make_index_sequence<Is>()), ...);
+	(impl_matrix::_lu_backward_row<N - 1 - Is>(lu, x, std::make_index_sequence<Is>()), ...);
+}
+
+template<size_t Col
+	,class T
+	,size_t N
+	,class Rhs
+	,class Ret
+	,size_t... Is>
+constexpr
+void
+_lu_solve_column(const _lu_decomposition<T, N>& d, const Rhs& rhs, Ret& ret, std::index_sequence<Is...>)
+{
+	T x[N] = { };
+	((x[Is] = static_cast<T>(rhs.value(d.perm[Is], Col))), ...);
+	impl_matrix::_lu_substitute(d.lu, x, std::index_sequence<Is...>());
+	((ret.value(Is, Col) = impl_matrix::_lu_cast<typename Ret::value_type>(x[Is])), ...);
+}
+
+template<size_t Col
+	,class T
+	,size_t N
+	,class Ret
+	,size_t... Is>
+constexpr
+void
+_lu_invert_column(const _lu_decomposition<T, N>& d, Ret& ret, std::index_sequence<Is...>)
+{
+	T x[N] = { };
+	((x[Is] = (d.perm[Is] == Col ? T(1) : T())), ...);
+	impl_matrix::_lu_substitute(d.lu, x, std::index_sequence<Is...>());
+	((ret.value(Is, Col) = impl_matrix::_lu_cast<typename Ret::value_type>(x[Is])), ...);
+}
+
+template<class T
+	,size_t N
+	,class Rhs
+	,class Ret
+	,size_t... Cols>
+constexpr
+void
+_lu_solve(const _lu_decomposition<T, N>& d, const Rhs& rhs, Ret& ret, std::index_sequence<Cols...>)
+{
+	(impl_matrix::_lu_solve_column<Cols>(d, rhs, ret, std::make_index_sequence<N>()), ...);
+}
+
+template<class T
+	,size_t N
+	,class Ret
+	,size_t... Cols>
+constexpr
+void
+_lu_invert(const _lu_decomposition<T, N>& d, Ret& ret, std::index_sequence<Cols...>)
+{
+	(impl_matrix::_lu_invert_column<Cols>(d, ret, std::make_index_sequence<N>()), ...);
+}
+
+} // namespace impl_matrix
+
+
+
 template<class Derived
 	,class Base>
 class _matrix_detinv_base :
@@ -1062,7 +1649,9 @@ public:
 						this->value(2, 1)*this->value(3, 0) - this->value(2, 0)*this->value(3, 1))));
 
 		} else {
-			return value_type();
+			using val_type = std::conditional_t<std::is_integral_v<value_type>, double, value_type>;
+			const auto lu = impl_matrix::_lu_decompose<val_type, dimension>(*this);
+			return impl_matrix::_lu_cast<value_type>(lu.det);
 		}
 	}
 
@@ -1070,9 +1659,13 @@ public:
 	bool
 	is_invertible() const
 	{
-		const auto det = this->determinant();
-		const auto det_pos = (det < value_type() ? -det : det);
-		return (det_pos > std::numeric_limits<value_type>::epsilon());
+		if constexpr (dimension <= 4) {
+			const auto det = this->determinant();
+			return (impl_matrix::_lu_abs(det) > std::numeric_limits<impl_matrix::_real_type_t<value_type>>::epsilon());
+		} else {
+			using val_type = std::conditional_t<std::is_integral_v<value_type>, double, value_type>;
+			return !impl_matrix::_lu_decompose<val_type, dimension>(*this).singular;
+		}
 	}
 
 
@@ -1085,8 +1678,8 @@ public:
 
 		if constexpr (dimension == 2) {
 			const auto det = this->determinant();
-			const auto pos_det = (det < val_type() ? -det : det);
-			if (pos_det <=  std::numeric_limits<value_type>::epsilon())
+			const auto pos_det = impl_matrix::_lu_abs(det);
+			if (pos_det <= std::numeric_limits<impl_matrix::_real_type_t<value_type>>::epsilon())
 				return std::optional<ret_mat>();
 
 			const auto det_inv = value_type(1) / det;
@@ -1102,8 +1695,8 @@ public:
 			const auto c2 = static_cast<value_type>(this->value(1, 2)*this->value(2, 0) - this->value(1, 0)*this->value(2, 2));
 
 			const auto det = this->value(0, 0)*c1 + this->value(0, 1)*c2 + this->value(0, 2)*c0;
-			const auto pos_det = (det < val_type() ? -det : det);
-			if (pos_det <=  std::numeric_limits<value_type>::epsilon())
+			const auto pos_det = impl_matrix::_lu_abs(det);
+			if (pos_det <= std::numeric_limits<impl_matrix::_real_type_t<value_type>>::epsilon())
 				return std::optional<ret_mat>();
 
 			const auto det_inv = value_type(1) / det;
@@ -1134,8 +1727,8 @@ public:
 			const auto c5 = static_cast<value_type>(this->value(2, 2)*this->value(3, 3) - this->value(3, 2)*this->value(2, 3));
 
 			const auto det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
-			const auto pos_det = (det < val_type() ? -det : det);
-			if (pos_det <=  std::numeric_limits<value_type>::epsilon())
+			const auto pos_det = impl_matrix::_lu_abs(det);
+			if (pos_det <= std::numeric_limits<impl_matrix::_real_type_t<value_type>>::epsilon())
 				return std::optional<ret_mat>();
 
 			const auto det_inv = value_type(1) / det;
@@ -1157,14 +1750,42 @@ public:
 			const auto m44 = ( this->value(2, 0)*s3 - this->value(2, 1)*s1 + this->value(2, 2)*s0)*det_inv;
 			return std::optional<ret_mat>(ret_mat{m11, m12, m13, m14, m21, m22, m23, m24, m31, m32, m33, m34, m41, m42, m43, m44});
 		} else {
-			return std::optional<ret_mat>();
+			const auto lu = impl_matrix::_lu_decompose<val_type, dimension>(*this);
+			if (lu.singular)
+				return std::optional<ret_mat>();
+
+			ret_mat ret;
+			impl_matrix::_lu_invert(lu, ret, std::make_index_sequence<dimension>());
+			return std::optional<ret_mat>(ret);
 		}
 	}
-};
 
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<(Other::row_dimension == dimension)> = 0
+		,_require<(Other::column_dimension != dynamic_extent)> = 0
+#endif
+	>
+	constexpr
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		using val_type = std::conditional_t<std::is_integral_v<value_type>, double, value_type>;
+		using ret_mat = typename _linalg_traits<Derived>::template matrix_type<value_type, dimension, Other::column_dimension, options>;
 
+		const auto lu = impl_matrix::_lu_decompose<val_type, dimension>(*this);
+		if (lu.singular)
+			return std::optional<ret_mat>();
 
-template<class Derived
+		ret_mat ret;
+		impl_matrix::_lu_solve(lu, rhs, ret, std::make_index_sequence<Other::column_dimension>());
+		return std::optional<ret_mat>(ret);
+	}
+};
+
+
+
+template<class Derived
 	,class Base>
 class _matrix_detinv_fp_base :
 	public Base
@@ -1192,7 +1813,7 @@ class _matrix_vector_base :
 public:
 	using typename Base::value_type;
 	using typename Base::size_type;
-	using norm_type = std::conditional_t<std::is_floating_point_v<value_type>, value_type, double>;
+	using norm_type = std::conditional_t<std::is_floating_point_v<impl_matrix::_real_type_t<value_type>>, impl_matrix::_real_type_t<value_type>, double>;
 
 	using Base::row_dimension;
 	using Base::column_dimension;
@@ -1208,9 +1829,21 @@ public:
 	norm_type
 	norm_squared() const
 	{
-		return this->dot(*this);
+		if constexpr (impl_matrix::_is_complex<value_type>::value) {
+			norm_type sum = {};
+			const size_type sz = this->size();
+			for (size_type i = 0; i < sz; ++i) {
+				const value_type val = this->value(i);
+				sum += val.real()*val.real() + val.imag()*val.imag();
+			}
+
+			return sum;
+		} else {
+			return this->dot(*this);
+		}
 	}
 
+	// Conjugates the left operand for complex scalars, sum of conj(this[i])*other[i].
 	template<class Other
 		,_require<_is_matrix_compatible<Derived, Other>::value> = 0>
 	constexpr
@@ -1222,7 +1855,7 @@ public:
 		value_type sum = {};
 		const size_type sz = this->size();
 		for (size_type i = 0; i < sz; ++i) {
-			sum += this->value(i)*other.value(i);
+			sum += impl_matrix::_mul(impl_matrix::_conj(this->value(i)), other.value(i));
 		}
 
 		return sum;
@@ -1231,7 +1864,8 @@ public:
 	auto
 	normalized() const
 	{
-		using ret_type = typename _linalg_traits<Derived>::template matrix_type<norm_type, row_dimension, column_dimension, options>;
+		using scalar_type = std::conditional_t<impl_matrix::_is_complex<value_type>::value, value_type, norm_type>;
+		using ret_type = typename _linalg_traits<Derived>::template matrix_type<scalar_type, row_dimension, column_dimension, options>;
 		ret_type ret(*this);
 		return ret /= this->norm();
 	}
@@ -1387,7 +2021,7 @@ struct _matrix_base_selector
 
 	static constexpr bool is_continuous = std::is_pointer_v<iterator>;
 	static constexpr bool is_square = (row_dim == col_dim) && (row_dim != 1) && (row_dim != dynamic_extent);
-	static constexpr bool has_det = (row_dim >= 2) && (row_dim <= 4);
+	static constexpr bool has_det = (row_dim >= 2) && (row_dim <= 8);
 	static constexpr bool is_vector = ((row_dim == 1) || (col_dim == 1));
 	static constexpr bool is_vec3 = (row_dim*col_dim == 3);
 	static constexpr bool has_xy = ((row_dim*col_dim >= 2) && (row_dim*col_dim <= 4));
@@ -1404,13 +2038,13 @@ struct _matrix_base_selector
 	using base4 = std::conditional_t<is_square && has_det,
 		_matrix_detinv_base<Derived, base3>,
 		base3>;
-	using base5 = std::conditional_t<is_square && has_det && std::is_floating_point_v<value_type>,
+	using base5 = std::conditional_t<is_square && has_det && std::is_floating_point_v<impl_matrix::_real_type_t<value_type>>,
 		_matrix_detinv_fp_base<Derived, base4>,
 		base4>;
 	using base6 = std::conditional_t<is_vector,
 		_matrix_vector_base<Derived, base5>,
 		base5>;
-	using base7 = std::conditional_t<is_vector && std::is_floating_point_v<value_type>,
+	using base7 = std::conditional_t<is_vector && std::is_floating_point_v<impl_matrix::_real_type_t<value_type>>,
 		_matrix_vector_normalize_base<Derived, base6>,
 		base6>;
 	using base8 = std::conditional_t<is_vector && is_vec3,
@@ -1613,6 +2247,212 @@ private:
 	_idx_type m_idx;
 };
 
+// Walks a row, column or diagonal of a tiled matrix, mapping each position through the tile layout.
+template<class Iter
+	,bool IsColumnMajor>
+class _matrix_tile_iterator
+{
+public:
+	using value_type = iter::value_type<Iter>;
+	using reference = iter::reference<Iter>;
+	using pointer = iter::pointer<Iter>;
+	using difference_type = iter::difference_type<Iter>;
+	using iterator_category = std::random_access_iterator_tag;
+
+	using _idx_type = std::make_unsigned_t<difference_type>;
+
+	constexpr
+	_matrix_tile_iterator() = default;
+
+	_matrix_tile_iterator(Iter iter, size_t rows, size_t cols, size_t row, size_t col, size_t row_step, size_t col_step, _idx_type idx) :
+		m_iter(iter),
+		m_rows(rows),
+		m_cols(cols),
+		m_row(row),
+		m_col(col),
+		m_row_step(row_step),
+		m_col_step(col_step),
+		m_idx(idx)
+	{ }
+
+	template<class OtherIt
+		,_require<std::is_convertible_v<OtherIt, Iter>> = 0>
+	_matrix_tile_iterator(const _matrix_tile_iterator<OtherIt, IsColumnMajor>& other) :
+		m_iter(other.m_iter),
+		m_rows(other.m_rows),
+		m_cols(other.m_cols),
+		m_row(other.m_row),
+		m_col(other.m_col),
+		m_row_step(other.m_row_step),
+		m_col_step(other.m_col_step),
+		m_idx(other.m_idx)
+	{ }
+
+	constexpr
+	reference
+	operator*() const
+	{
+		return *this->_current();
+	}
+
+	constexpr
+	Iter
+	operator->() const
+	{
+		return this->_current();
+	}
+
+	constexpr
+	reference
+	operator[](difference_type idx) const
+	{
+		return *(*this + idx);
+	}
+
+	friend constexpr
+	_matrix_tile_iterator&
+	operator++(_matrix_tile_iterator& rhs)
+	{
+		++rhs.m_idx;
+		return rhs;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator
+	operator++(_matrix_tile_iterator& lhs, int)
+	{
+		auto cp = lhs;
+		++lhs;
+		return cp;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator&
+	operator--(_matrix_tile_iterator& rhs)
+	{
+		--rhs.m_idx;
+		return rhs;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator
+	operator--(_matrix_tile_iterator& lhs, int)
+	{
+		auto cp = lhs;
+		--lhs;
+		return cp;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator&
+	operator+=(_matrix_tile_iterator& lhs, difference_type rhs)
+	{
+		lhs.m_idx += rhs;
+		return lhs;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator&
+	operator-=(_matrix_tile_iterator& lhs, difference_type rhs)
+	{
+		lhs.m_idx -= rhs;
+		return lhs;
+	}
+
+	friend constexpr
+	_matrix_tile_iterator
+	operator+(_matrix_tile_iterator lhs, difference_type rhs)
+	{
+		return (lhs += rhs);
+	}
+
+	friend constexpr
+	_matrix_tile_iterator
+	operator+(difference_type lhs, _matrix_tile_iterator rhs)
+	{
+		return (rhs += lhs);
+	}
+
+	friend constexpr
+	_matrix_tile_iterator
+	operator-(_matrix_tile_iterator lhs, difference_type rhs)
+	{
+		return (lhs -= rhs);
+	}
+
+	friend constexpr
+	difference_type
+	operator-(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return difference_type(lhs.m_idx) - difference_type(rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator==(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx == rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator!=(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx != rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator<(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx < rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator>(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx > rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator<=(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx <= rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator>=(const _matrix_tile_iterator& lhs, const _matrix_tile_iterator& rhs)
+	{
+		return (lhs.m_idx >= rhs.m_idx);
+	}
+
+private:
+	constexpr
+	Iter
+	_current() const
+	{
+		const size_t row = m_row + m_row_step*m_idx;
+		const size_t col = m_col + m_col_step*m_idx;
+		return m_iter + impl_matrix::_tiled_offset<IsColumnMajor>(m_rows, m_cols, row, col);
+	}
+
+	template<class OtherIter
+		,bool OtherIsColumnMajor>
+	friend class _matrix_tile_iterator;
+
+	Iter m_iter;
+	size_t m_rows;
+	size_t m_cols;
+	size_t m_row;
+	size_t m_col;
+	size_t m_row_step;
+	size_t m_col_step;
+	_idx_type m_idx;
+};
+
 template<class Iter
 	,class ConstIter
 	,size_t R
@@ -1689,7 +2529,10 @@ template<class Iter
 class _matrix_vector_iterator
 {
 public:
-	using value_type = _vector_reference<_matrix_stride_iterator<Iter>, _matrix_stride_iterator<ConstIter>, (IsRow ? 1 : R), (IsRow ? C : 1), Opt>;
+	using _element_iterator = _matrix_element_iterator<Iter, R, C, Opt>;
+	using _const_element_iterator = _matrix_element_iterator<ConstIter, R, C, Opt>;
+
+	using value_type = _vector_reference<_element_iterator, _const_element_iterator, (IsRow ? 1 : R), (IsRow ? C : 1), Opt>;
 	using reference = value_type;
 	using pointer = struct {
 		value_type value;
@@ -1707,6 +2550,10 @@ public:
 	bool
 	_is_column_major = ((Opt & matrix_options::column_major) == matrix_options::column_major);
 
+	static constexpr
+	bool
+	_is_tiled = impl_matrix::_is_tiled<R, C, Opt>;
+
 	constexpr
 	_matrix_vector_iterator() = default;
 
@@ -1896,13 +2743,16 @@ private:
 	reference
 	_get_row() const
 	{
-		if constexpr (_is_column_major) {
+		if constexpr (_is_tiled) {
+			auto it = _element_iterator(m_iter, this->_rows(), this->_cols(), m_idx, 0, 0, 1, 0);
+			return reference(it, this->_cols());
+		} else if constexpr (_is_column_major) {
 			auto first = m_iter + m_idx;
-			auto it = _matrix_stride_iterator<Iter>(first, this->_rows(), 0);
+			auto it = _element_iterator(first, this->_rows(), 0);
 			return reference(it, this->_cols());
 		} else {
 			auto first = m_iter + m_idx*this->_cols();
-			auto it = _matrix_stride_iterator<Iter>(first, 1, 0);
+			auto it = _element_iterator(first, 1, 0);
 			return reference(it, this->_cols());
 		}
 	}
@@ -1911,13 +2761,16 @@ private:
 	reference
 	_get_col() const
 	{
-		if constexpr (_is_column_major) {
+		if constexpr (_is_tiled) {
+			auto it = _element_iterator(m_iter, this->_rows(), this->_cols(), 0, m_idx, 1, 0, 0);
+			return reference(it, this->_rows());
+		} else if constexpr (_is_column_major) {
 			auto first = m_iter + m_idx*this->_rows();
-			auto it = _matrix_stride_iterator<Iter>(first, 1, 0);
+			auto it = _element_iterator(first, 1, 0);
 			return reference(it, this->_rows());
 		} else {
 			auto first = m_iter + m_idx;
-			auto it = _matrix_stride_iterator<Iter>(first, this->_cols(), 0);
+			auto it = _element_iterator(first, this->_cols(), 0);
 			return reference(it, this->_rows());
 		}
 	}
@@ -2142,6 +2995,29 @@ operator/(const _matrix_base<Mat>& lhs, typename Mat::value_type rhs)
 	return (ret /= rhs);
 }
 
+
+
+namespace impl_matrix {
+
+// Row times column, unlike dot() the left operand is never conjugated.
+template<class VecA
+	,class VecB>
+constexpr
+auto
+_dotu(const VecA& lhs, const VecB& rhs)
+{
+	typename VecA::value_type sum = {};
+	const size_t sz = lhs.size();
+	for (size_t i = 0; i < sz; ++i)
+		sum += impl_matrix::_mul(lhs.value(i), rhs.value(i));
+
+	return sum;
+}
+
+} // namespace impl_matrix
+
+
+
 template<class MatA
 	,class MatB
 	,_require<std::is_same_v<typename MatA::value_type, typename MatB::value_type>> = 0
@@ -2163,11 +3039,11 @@ operator*(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs)
 
 	const auto rows = lhs.rows();
 	const auto cols = rhs.columns();
-	auto ret = mtk::_make_matrix<ret_type>(rows, cols);
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(rows, cols);
 	for (size_t row = 0; row < rows; ++row) {
 		const auto row_vec = lhs.row(row);
 		for (size_t col = 0; col < cols; ++col) {
-			ret.value(row, col) = row_vec.dot(rhs.column(col));
+			ret.value(row, col) = impl_matrix::_dotu(row_vec, rhs.column(col));
 		}
 	}
 
@@ -2192,12 +3068,12 @@ operator*=(_matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs)
 
 	const auto rows = lhs.rows();
 	const auto cols = lhs.columns();
-	auto tmp_vector = mtk::_make_matrix<tmp_vector_type>(1, cols);
+	auto tmp_vector = mtk::_make_matrix_for_overwrite<tmp_vector_type>(1, cols);
 
 	for (size_t row = 0; row < rows; ++row) {
 		auto row_vec = lhs.row(row);
 		for (size_t col = 0; col < cols; ++col) {
-			tmp_vector.value(col) = row_vec.dot(rhs.column(col));
+			tmp_vector.value(col) = impl_matrix::_dotu(row_vec, rhs.column(col));
 		}
 		row_vec = tmp_vector;
 	}
@@ -2225,7 +3101,7 @@ public:
 		,_require<(sizeof...(Args) == R*C)> = 0
 		,_require<impl_matrix::_fold_is_convertible_to<S, Args...>> = 0
 		,matrix_options O = Opt
-		,_require<(O & matrix_options::column_major) != matrix_options::column_major> = 0
+		,_require<impl_matrix::_is_row_major_storage<O>> = 0
 #endif
 	>
 	constexpr
@@ -2238,7 +3114,7 @@ public:
 		,_require<(sizeof...(Args) == R*C)> = 0
 		,_require<impl_matrix::_fold_is_convertible_to<S, Args...>> = 0
 		,matrix_options O = Opt
-		,_require<(O & matrix_options::column_major) == matrix_options::column_major> = 0>
+		,_require<!impl_matrix::_is_row_major_storage<O>> = 0>
 	constexpr
 	matrix(Args&& ...args) :
 		m_data{ }
@@ -2286,9 +3162,27 @@ public:
 		m_cols(cols)
 	{ }
 
+	explicit
+	matrix(size_t cols, memory_placement placement) :
+		m_data(R*cols, placement),
+		m_cols(cols)
+	{ }
+
+	// Leaves the elements uninitialized, every element must be written before it is read.
+	matrix(size_t cols, for_overwrite_t) :
+		m_data(R*cols, for_overwrite),
+		m_cols(cols)
+	{ }
+
+	// Allocates the storage from resource, which resizes and copies keep using.
+	matrix(size_t cols, memory_resource& resource) :
+		m_data(R*cols, resource),
+		m_cols(cols)
+	{ }
+
 #ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) != matrix_options::column_major)> = 0>
+		,_require<impl_matrix::_is_row_major_storage<O>> = 0>
 #endif
 	matrix(std::initializer_list<S> args) :
 		m_data(args),
@@ -2299,7 +3193,7 @@ public:
 
 #ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) == matrix_options::column_major)> = 0>
+		,_require<!impl_matrix::_is_row_major_storage<O>> = 0>
 	matrix(std::initializer_list<S> args) :
 		matrix(args.size() / R)
 	{
@@ -2322,6 +3216,14 @@ public:
 			this->_assign_rows(other.begin_rows());
 	}
 
+	// Keeps the overlapping elements in place, new elements are value initialized.
+	void
+	conservative_resize(size_t cols)
+	{
+		impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, R, m_cols, R, cols, 0);
+		m_cols = cols;
+	}
+
 private:
 	friend struct _linalg_traits<matrix>;
 	array<S, dynamic_extent> m_data;
@@ -2346,9 +3248,27 @@ public:
 		m_rows(rows)
 	{ }
 
+	explicit
+	matrix(size_t rows, memory_placement placement) :
+		m_data(rows*C, placement),
+		m_rows(rows)
+	{ }
+
+	// Leaves the elements uninitialized, every element must be written before it is read.
+	matrix(size_t rows, for_overwrite_t) :
+		m_data(rows*C, for_overwrite),
+		m_rows(rows)
+	{ }
+
+	// Allocates the storage from resource, which resizes and copies keep using.
+	matrix(size_t rows, memory_resource& resource) :
+		m_data(rows*C, resource),
+		m_rows(rows)
+	{ }
+
 #ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) != matrix_options::column_major)> = 0>
+		,_require<impl_matrix::_is_row_major_storage<O>> = 0>
 #endif
 	matrix(std::initializer_list<S> args) :
 		m_data(args),
@@ -2359,7 +3279,7 @@ public:
 
 #ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) == matrix_options::column_major)> = 0>
+		,_require<!impl_matrix::_is_row_major_storage<O>> = 0>
 	matrix(std::initializer_list<S> args) :
 		matrix(args.size() / C)
 	{
@@ -2382,7 +3302,90 @@ public:
 			this->_assign_rows(other.begin_rows());
 	}
 
+	// Number of elements the storage holds before it has to reallocate.
+	size_t
+	capacity() const noexcept
+	{
+		return m_data.size();
+	}
+
+	// Keeps the overlapping elements in place, new elements are value initialized.
+	void
+	conservative_resize(size_t rows)
+	{
+		impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, C, rows, C, 0);
+		m_rows = rows;
+	}
+
+	// Appending up to rows rows then does not reallocate. Row major storage leaves the existing rows in place,
+	// row major tiles move at most the last tile row, column major storage moves every element on each append.
+	void
+	reserve_rows(size_t rows)
+	{
+		if (rows*C > m_data.size())
+			impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, C, m_rows, C, rows*C);
+	}
+
+	// Grows the storage geometrically, appending is amortized O(columns()) for row major storage
+	// and O(size()) for column major storage, which moves the elements in place.
+	template<class Row
+#ifndef MTK_DOXYGEN
+		,_require<std::is_convertible_v<typename Row::value_type, S>> = 0
+#endif
+	>
+	void
+	append_row(const _matrix_base<Row>& row)
+	{
+		MTK_ASSERT(row.size() == C);
+
+		// row may view this matrix, unless the elements stay in place it is copied before growing.
+		if (this->_appends_in_place()) {
+			this->_grow_row();
+			this->_assign_last_row(row.begin());
+		} else {
+			array<S, dynamic_extent> tmp(C, for_overwrite);
+			size_t col = 0;
+			for (const auto& val : row)
+				tmp[col++] = static_cast<S>(val);
+
+			this->_grow_row();
+			this->_assign_last_row(std::make_move_iterator(tmp.begin()));
+		}
+	}
+
+	void
+	append_row(std::initializer_list<S> row)
+	{
+		MTK_ASSERT(row.size() == C);
+
+		this->_grow_row();
+		this->_assign_last_row(row.begin());
+	}
+
 private:
+	bool
+	_appends_in_place() const noexcept
+	{
+		return !matrix::_is_column_major && !matrix::_is_tiled && ((m_rows + 1)*C <= m_data.size());
+	}
+
+	// Adds a row and grows the capacity in the same relayout.
+	void
+	_grow_row()
+	{
+		const size_t capacity = ((m_rows + 1)*C > m_data.size() ? (m_rows < 4 ? 4 : 2*m_rows)*C : 0);
+		impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, C, m_rows + 1, C, capacity);
+		++m_rows;
+	}
+
+	template<class Iter>
+	void
+	_assign_last_row(Iter it)
+	{
+		for (size_t col = 0; col < C; ++col, ++it)
+			this->value(m_rows - 1, col) = *it;
+	}
+
 	friend struct _linalg_traits<matrix>;
 	array<S, dynamic_extent> m_data;
 	size_t m_rows;
@@ -2407,9 +3410,32 @@ public:
 		m_cols(cols)
 	{ }
 
+	// Places the storage of large matrices across NUMA nodes, see memory_placement.
+	explicit
+	matrix(size_t rows, size_t cols, memory_placement placement) :
+		m_data(rows*cols, placement),
+		m_rows(rows),
+		m_cols(cols)
+	{ }
+
+	// Leaves the elements uninitialized, every element must be written before it is read.
+	matrix(size_t rows, size_t cols, for_overwrite_t) :
+		m_data(rows*cols, for_overwrite),
+		m_rows(rows),
+		m_cols(cols)
+	{ }
+
+	// Allocates the storage from resource, e.g. an aligned_resource for SIMD friendly rows.
+	// Resizes and copies keep using resource.
+	matrix(size_t rows, size_t cols, memory_resource& resource) :
+		m_data(rows*cols, resource),
+		m_rows(rows),
+		m_cols(cols)
+	{ }
+
 	#ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) != matrix_options::column_major)> = 0>
+		,_require<impl_matrix::_is_row_major_storage<O>> = 0>
 #endif
 	matrix(size_t rows, size_t cols, std::initializer_list<S> args) :
 		m_data(args),
@@ -2421,7 +3447,7 @@ public:
 
 #ifndef MTK_DOXYGEN
 	template<matrix_options O = Opt
-		,_require<((O & matrix_options::column_major) == matrix_options::column_major)> = 0>
+		,_require<!impl_matrix::_is_row_major_storage<O>> = 0>
 	matrix(size_t rows, size_t cols, std::initializer_list<S> args) :
 		matrix(rows, cols)
 	{
@@ -2441,7 +3467,92 @@ public:
 		this->_assign_rows(other.begin_rows());
 	}
 
+	// Number of elements the storage holds before it has to reallocate.
+	size_t
+	capacity() const noexcept
+	{
+		return m_data.size();
+	}
+
+	// Keeps the overlapping elements in place, new elements are value initialized.
+	void
+	conservative_resize(size_t rows, size_t cols)
+	{
+		impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, m_cols, rows, cols, 0);
+		m_rows = rows;
+		m_cols = cols;
+	}
+
+	// Appending up to rows rows then does not reallocate. Row major storage leaves the existing rows in place,
+	// row major tiles move at most the last tile row, column major storage moves every element on each append.
+	void
+	reserve_rows(size_t rows)
+	{
+		if (rows*m_cols > m_data.size())
+			impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, m_cols, m_rows, m_cols, rows*m_cols);
+	}
+
+	// Grows the storage geometrically, appending is amortized O(columns()) for row major storage
+	// and O(size()) for column major storage, which moves the elements in place.
+	// The first row appended to an empty matrix sets the number of columns.
+	template<class Row
+#ifndef MTK_DOXYGEN
+		,_require<std::is_convertible_v<typename Row::value_type, S>> = 0
+#endif
+	>
+	void
+	append_row(const _matrix_base<Row>& row)
+	{
+		// row may view this matrix, unless the elements stay in place it is copied before growing.
+		if (this->_appends_in_place(row.size())) {
+			this->_grow_row(row.size());
+			this->_assign_last_row(row.begin());
+		} else {
+			array<S, dynamic_extent> tmp(row.size(), for_overwrite);
+			size_t col = 0;
+			for (const auto& val : row)
+				tmp[col++] = static_cast<S>(val);
+
+			this->_grow_row(row.size());
+			this->_assign_last_row(std::make_move_iterator(tmp.begin()));
+		}
+	}
+
+	void
+	append_row(std::initializer_list<S> row)
+	{
+		this->_grow_row(row.size());
+		this->_assign_last_row(row.begin());
+	}
+
 private:
+	bool
+	_appends_in_place(size_t cols) const noexcept
+	{
+		return !matrix::_is_column_major && !matrix::_is_tiled && ((m_rows + 1)*cols <= m_data.size());
+	}
+
+	// Adds a row and grows the capacity in the same relayout.
+	void
+	_grow_row(size_t cols)
+	{
+		if (m_rows == 0)
+			m_cols = cols;
+		MTK_ASSERT(cols == m_cols);
+
+		const size_t capacity = ((m_rows + 1)*m_cols > m_data.size() ? (m_rows < 4 ? 4 : 2*m_rows)*m_cols : 0);
+		impl_matrix::_resize_storage<matrix::_is_column_major, matrix::_is_tiled>(m_data, m_rows, m_cols, m_rows + 1, m_cols, capacity);
+		++m_rows;
+	}
+
+	template<class Iter>
+	void
+	_assign_last_row(Iter it)
+	{
+		for (size_t col = 0; col < m_cols; ++col, ++it)
+			this->value(m_rows - 1, col) = *it;
+	}
+
 	friend struct _linalg_traits<matrix>;
 	array<S, dynamic_extent> m_data;
 	size_t m_rows;
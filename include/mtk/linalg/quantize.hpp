@@ -0,0 +1,90 @@
+#ifndef MTK_LINALG_QUANTIZE_HPP
+#define MTK_LINALG_QUANTIZE_HPP
+
+#include <mtk/core/saturate_cast.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace mtk {
+
+template<class Int = int8_t
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_integral_v<Int>> = 0
+	,_require<std::is_floating_point_v<typename Mat::value_type>> = 0
+#endif
+>
+typename Mat::value_type
+quantization_scale(const _matrix_base<Mat>& m)
+{
+	using value_type = typename Mat::value_type;
+
+	value_type max_abs = value_type();
+	for (const auto& el : m) {
+		const value_type abs = std::fabs(el);
+		if (abs > max_abs)
+			max_abs = abs;
+	}
+
+	if (max_abs == value_type())
+		return value_type(1);
+
+	return max_abs / static_cast<value_type>(std::numeric_limits<Int>::max());
+}
+
+template<class Int = int8_t
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_integral_v<Int>> = 0
+	,_require<std::is_floating_point_v<typename Mat::value_type>> = 0
+#endif
+>
+auto
+quantize(const _matrix_base<Mat>& m, typename Mat::value_type scale)
+{
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Int, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	const auto rows = m.rows();
+	const auto cols = m.columns();
+	const auto inv_scale = typename Mat::value_type(1) / scale;
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(rows, cols);
+	for (size_t row = 0; row < rows; ++row) {
+		for (size_t col = 0; col < cols; ++col)
+			ret.value(row, col) = mtk::saturate_cast<Int>(std::nearbyint(m.value(row, col)*inv_scale));
+	}
+
+	return ret;
+}
+
+template<class Float = float
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_floating_point_v<Float>> = 0
+	,_require<std::is_integral_v<typename Mat::value_type>> = 0
+#endif
+>
+auto
+dequantize(const _matrix_base<Mat>& m, Float scale)
+{
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Float, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	const auto rows = m.rows();
+	const auto cols = m.columns();
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(rows, cols);
+	for (size_t row = 0; row < rows; ++row) {
+		for (size_t col = 0; col < cols; ++col)
+			ret.value(row, col) = static_cast<Float>(m.value(row, col))*scale;
+	}
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
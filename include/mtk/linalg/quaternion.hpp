@@ -0,0 +1,488 @@
+#ifndef MTK_LINALG_QUATERNION_HPP
+#define MTK_LINALG_QUATERNION_HPP
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/span.hpp>
+#include <mtk/core/trigonometry.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace mtk {
+
+template<class T>
+class quaternion
+{
+public:
+	static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
+
+	using value_type = T;
+	using size_type = size_t;
+
+	constexpr
+	quaternion() noexcept :
+		m_data()
+	{ }
+
+	constexpr
+	quaternion(T w, T x, T y, T z) noexcept :
+		m_data{x, y, z, w}
+	{ }
+
+	constexpr
+	quaternion(T w, const vector<T, 3>& vec) noexcept :
+		m_data{vec.value(0), vec.value(1), vec.value(2), w}
+	{ }
+
+	static constexpr
+	quaternion
+	identity() noexcept
+	{
+		return quaternion(T(1), T(), T(), T());
+	}
+
+	template<class Traits>
+	static
+	quaternion
+	from_axis_angle(const vector<T, 3>& axis, basic_angle<T, Traits> angle)
+	{
+		const auto half_angle = angle / T(2);
+		const T s = mtk::sin(half_angle);
+		return quaternion(mtk::cos(half_angle), axis.value(0)*s, axis.value(1)*s, axis.value(2)*s);
+	}
+
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<(Mat::row_dimension == Mat::column_dimension)> = 0
+		,_require<(Mat::row_dimension == 3) || (Mat::row_dimension == 4)> = 0
+#endif
+	>
+	static
+	quaternion
+	from_matrix(const _matrix_base<Mat>& m)
+	{
+		const T m00 = static_cast<T>(m.value(0, 0));
+		const T m01 = static_cast<T>(m.value(0, 1));
+		const T m02 = static_cast<T>(m.value(0, 2));
+		const T m10 = static_cast<T>(m.value(1, 0));
+		const T m11 = static_cast<T>(m.value(1, 1));
+		const T m12 = static_cast<T>(m.value(1, 2));
+		const T m20 = static_cast<T>(m.value(2, 0));
+		const T m21 = static_cast<T>(m.value(2, 1));
+		const T m22 = static_cast<T>(m.value(2, 2));
+
+		const T trace = m00 + m11 + m22;
+		if (trace > T()) {
+			const T s = std::sqrt(trace + T(1))*T(2);
+			return quaternion(s / T(4), (m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s);
+		} else if ((m00 > m11) && (m00 > m22)) {
+			const T s = std::sqrt(T(1) + m00 - m11 - m22)*T(2);
+			return quaternion((m21 - m12) / s, s / T(4), (m01 + m10) / s, (m02 + m20) / s);
+		} else if (m11 > m22) {
+			const T s = std::sqrt(T(1) + m11 - m00 - m22)*T(2);
+			return quaternion((m02 - m20) / s, (m01 + m10) / s, s / T(4), (m12 + m21) / s);
+		} else {
+			const T s = std::sqrt(T(1) + m22 - m00 - m11)*T(2);
+			return quaternion((m10 - m01) / s, (m02 + m20) / s, (m12 + m21) / s, s / T(4));
+		}
+	}
+
+	constexpr
+	T&
+	x() noexcept
+	{
+		return m_data[0];
+	}
+
+	constexpr
+	const T&
+	x() const noexcept
+	{
+		return m_data[0];
+	}
+
+	constexpr
+	T&
+	y() noexcept
+	{
+		return m_data[1];
+	}
+
+	constexpr
+	const T&
+	y() const noexcept
+	{
+		return m_data[1];
+	}
+
+	constexpr
+	T&
+	z() noexcept
+	{
+		return m_data[2];
+	}
+
+	constexpr
+	const T&
+	z() const noexcept
+	{
+		return m_data[2];
+	}
+
+	constexpr
+	T&
+	w() noexcept
+	{
+		return m_data[3];
+	}
+
+	constexpr
+	const T&
+	w() const noexcept
+	{
+		return m_data[3];
+	}
+
+	constexpr
+	vector<T, 3>
+	vec() const
+	{
+		return vector<T, 3>(m_data[0], m_data[1], m_data[2]);
+	}
+
+	radians_t<T>
+	angle() const
+	{
+		const T w_val = (m_data[3] > T(1) ? T(1) : (m_data[3] < T(-1) ? T(-1) : m_data[3]));
+		return mtk::acos(w_val)*T(2);
+	}
+
+	vector<T, 3>
+	axis() const
+	{
+		const T s_squared = T(1) - m_data[3]*m_data[3];
+		if (s_squared <= std::numeric_limits<T>::epsilon())
+			return vector<T, 3>(T(1), T(), T());
+
+		const T s_inv = T(1) / std::sqrt(s_squared);
+		return vector<T, 3>(m_data[0]*s_inv, m_data[1]*s_inv, m_data[2]*s_inv);
+	}
+
+	constexpr
+	T
+	dot(const quaternion& other) const noexcept
+	{
+		return (m_data[0]*other.m_data[0] + m_data[1]*other.m_data[1] + m_data[2]*other.m_data[2] + m_data[3]*other.m_data[3]);
+	}
+
+	constexpr
+	T
+	norm_squared() const noexcept
+	{
+		return this->dot(*this);
+	}
+
+	T
+	norm() const
+	{
+		return std::sqrt(this->norm_squared());
+	}
+
+	void
+	normalize()
+	{
+		(*this) *= T(1) / this->norm();
+	}
+
+	quaternion
+	normalized() const
+	{
+		quaternion ret = *this;
+		ret.normalize();
+		return ret;
+	}
+
+	constexpr
+	void
+	conjugate() noexcept
+	{
+		m_data[0] = -m_data[0];
+		m_data[1] = -m_data[1];
+		m_data[2] = -m_data[2];
+	}
+
+	constexpr
+	quaternion
+	conjugated() const noexcept
+	{
+		return quaternion(m_data[3], -m_data[0], -m_data[1], -m_data[2]);
+	}
+
+	constexpr
+	quaternion
+	inverted() const
+	{
+		auto ret = this->conjugated();
+		ret /= this->norm_squared();
+		return ret;
+	}
+
+	constexpr
+	vector<T, 3>
+	rotate(const vector<T, 3>& vec) const
+	{
+		const T vx = vec.value(0);
+		const T vy = vec.value(1);
+		const T vz = vec.value(2);
+		const T tx = T(2)*(m_data[1]*vz - m_data[2]*vy);
+		const T ty = T(2)*(m_data[2]*vx - m_data[0]*vz);
+		const T tz = T(2)*(m_data[0]*vy - m_data[1]*vx);
+		return vector<T, 3>(
+			vx + m_data[3]*tx + (m_data[1]*tz - m_data[2]*ty),
+			vy + m_data[3]*ty + (m_data[2]*tx - m_data[0]*tz),
+			vz + m_data[3]*tz + (m_data[0]*ty - m_data[1]*tx));
+	}
+
+	constexpr
+	matrix<T, 3, 3>
+	to_matrix3() const
+	{
+		const T xx = m_data[0]*m_data[0];
+		const T yy = m_data[1]*m_data[1];
+		const T zz = m_data[2]*m_data[2];
+		const T xy = m_data[0]*m_data[1];
+		const T xz = m_data[0]*m_data[2];
+		const T yz = m_data[1]*m_data[2];
+		const T wx = m_data[3]*m_data[0];
+		const T wy = m_data[3]*m_data[1];
+		const T wz = m_data[3]*m_data[2];
+		return matrix<T, 3, 3>(
+			T(1) - T(2)*(yy + zz), T(2)*(xy - wz), T(2)*(xz + wy),
+			T(2)*(xy + wz), T(1) - T(2)*(xx + zz), T(2)*(yz - wx),
+			T(2)*(xz - wy), T(2)*(yz + wx), T(1) - T(2)*(xx + yy));
+	}
+
+	constexpr
+	matrix<T, 4, 4>
+	to_matrix4() const
+	{
+		const auto rot = this->to_matrix3();
+		return matrix<T, 4, 4>(
+			rot.value(0, 0), rot.value(0, 1), rot.value(0, 2), T(),
+			rot.value(1, 0), rot.value(1, 1), rot.value(1, 2), T(),
+			rot.value(2, 0), rot.value(2, 1), rot.value(2, 2), T(),
+			T(), T(), T(), T(1));
+	}
+
+	constexpr
+	quaternion&
+	operator+=(const quaternion& rhs) noexcept
+	{
+		for (size_t i = 0; i < 4; ++i)
+			m_data[i] += rhs.m_data[i];
+
+		return *this;
+	}
+
+	constexpr
+	quaternion&
+	operator-=(const quaternion& rhs) noexcept
+	{
+		for (size_t i = 0; i < 4; ++i)
+			m_data[i] -= rhs.m_data[i];
+
+		return *this;
+	}
+
+	constexpr
+	quaternion&
+	operator*=(const quaternion& rhs) noexcept
+	{
+		const T ax = m_data[0];
+		const T ay = m_data[1];
+		const T az = m_data[2];
+		const T aw = m_data[3];
+		const T bx = rhs.m_data[0];
+		const T by = rhs.m_data[1];
+		const T bz = rhs.m_data[2];
+		const T bw = rhs.m_data[3];
+		m_data[0] = aw*bx + ax*bw + ay*bz - az*by;
+		m_data[1] = aw*by + ay*bw + az*bx - ax*bz;
+		m_data[2] = aw*bz + az*bw + ax*by - ay*bx;
+		m_data[3] = aw*bw - ax*bx - ay*by - az*bz;
+		return *this;
+	}
+
+	constexpr
+	quaternion&
+	operator*=(T rhs) noexcept
+	{
+		for (size_t i = 0; i < 4; ++i)
+			m_data[i] *= rhs;
+
+		return *this;
+	}
+
+	constexpr
+	quaternion&
+	operator/=(T rhs) noexcept
+	{
+		for (size_t i = 0; i < 4; ++i)
+			m_data[i] /= rhs;
+
+		return *this;
+	}
+
+private:
+	alignas(4*sizeof(T)) T m_data[4];
+};
+
+
+
+template<class T>
+constexpr
+bool
+operator==(const quaternion<T>& lhs, const quaternion<T>& rhs) noexcept
+{
+	return ((lhs.x() == rhs.x()) && (lhs.y() == rhs.y()) && (lhs.z() == rhs.z()) && (lhs.w() == rhs.w()));
+}
+
+template<class T>
+constexpr
+bool
+operator!=(const quaternion<T>& lhs, const quaternion<T>& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator-(const quaternion<T>& rhs) noexcept
+{
+	return quaternion<T>(-rhs.w(), -rhs.x(), -rhs.y(), -rhs.z());
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator+(quaternion<T> lhs, const quaternion<T>& rhs) noexcept
+{
+	return lhs += rhs;
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator-(quaternion<T> lhs, const quaternion<T>& rhs) noexcept
+{
+	return lhs -= rhs;
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator*(quaternion<T> lhs, const quaternion<T>& rhs) noexcept
+{
+	return lhs *= rhs;
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator*(quaternion<T> lhs, T rhs) noexcept
+{
+	return lhs *= rhs;
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator*(T lhs, quaternion<T> rhs) noexcept
+{
+	return rhs *= lhs;
+}
+
+template<class T>
+constexpr
+quaternion<T>
+operator/(quaternion<T> lhs, T rhs) noexcept
+{
+	return lhs /= rhs;
+}
+
+template<class T>
+constexpr
+vector<T, 3>
+operator*(const quaternion<T>& lhs, const vector<T, 3>& rhs)
+{
+	return lhs.rotate(rhs);
+}
+
+
+
+template<class T>
+quaternion<T>
+nlerp(const quaternion<T>& from, const quaternion<T>& to, T t)
+{
+	const T sign = (from.dot(to) < T() ? T(-1) : T(1));
+	return (from*(T(1) - t) + to*(sign*t)).normalized();
+}
+
+template<class T>
+quaternion<T>
+slerp(const quaternion<T>& from, const quaternion<T>& to, T t)
+{
+	T cos_theta = from.dot(to);
+	T sign = T(1);
+	if (cos_theta < T()) {
+		cos_theta = -cos_theta;
+		sign = T(-1);
+	}
+
+	// sin(theta) vanishes as the inputs converge, nlerp is indistinguishable there.
+	if (cos_theta > T(0.9995))
+		return mtk::nlerp(from, to, t);
+
+	const auto theta = mtk::acos(cos_theta);
+	const T sin_theta_inv = T(1) / mtk::sin(theta);
+	const T from_weight = mtk::sin(theta*(T(1) - t))*sin_theta_inv;
+	const T to_weight = mtk::sin(theta*t)*sin_theta_inv*sign;
+	return from*from_weight + to*to_weight;
+}
+
+
+
+template<class T>
+void
+rotate(const quaternion<T>& q, span<const vector<T, 3>> src, span<vector<T, 3>> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+
+	const auto rot = q.to_matrix3();
+	const size_t size = src.size();
+	for (size_t i = 0; i < size; ++i)
+		dst[i] = rot*src[i];
+}
+
+template<class T>
+void
+rotate(const quaternion<T>& q, span<vector<T, 3>> vecs)
+{
+	mtk::rotate(q, span<const vector<T, 3>>(vecs.data(), vecs.size()), vecs);
+}
+
+void
+rotate(const quaternion<float>& q, span<const vector<float, 3>> src, span<vector<float, 3>> dst);
+
+void
+rotate(const quaternion<float>& q, span<vector<float, 3>> vecs);
+
+} // namespace mtk
+
+#endif
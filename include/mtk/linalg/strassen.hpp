@@ -0,0 +1,273 @@
+#ifndef MTK_LINALG_STRASSEN_HPP
+#define MTK_LINALG_STRASSEN_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/clamp.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/gemm.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <type_traits>
+
+namespace mtk {
+
+inline constexpr
+size_t
+strassen_default_cutoff = 128;
+
+namespace impl_strassen {
+
+inline
+size_t
+_workspace_size(size_t order, size_t cutoff)
+{
+	size_t ret = 0;
+	while (order > cutoff) {
+		const size_t half = order / 2;
+		ret += 2*half*half;
+		order = half;
+	}
+	return ret;
+}
+
+template<class T>
+void
+_add(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t n)
+{
+	for (size_t i = 0; i < n; ++i) {
+		const T* a_row = a + i*lda;
+		const T* b_row = b + i*ldb;
+		T* c_row = c + i*ldc;
+		for (size_t j = 0; j < n; ++j)
+			c_row[j] = a_row[j] + b_row[j];
+	}
+}
+
+template<class T>
+void
+_sub(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t n)
+{
+	for (size_t i = 0; i < n; ++i) {
+		const T* a_row = a + i*lda;
+		const T* b_row = b + i*ldb;
+		T* c_row = c + i*ldc;
+		for (size_t j = 0; j < n; ++j)
+			c_row[j] = a_row[j] - b_row[j];
+	}
+}
+
+template<class T>
+void
+_peel(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t n)
+{
+	const size_t m = n - 1;
+	const T* b_last_row = b + m*ldb;
+	for (size_t i = 0; i < m; ++i) {
+		const T a_val = a[i*lda + m];
+		T* c_row = c + i*ldc;
+		for (size_t j = 0; j < m; ++j)
+			c_row[j] += a_val*b_last_row[j];
+	}
+
+	for (size_t i = 0; i < m; ++i) {
+		const T* a_row = a + i*lda;
+		T sum = T();
+		for (size_t p = 0; p < n; ++p)
+			sum += a_row[p]*b[p*ldb + m];
+		c[i*ldc + m] = sum;
+	}
+
+	T* c_last_row = c + m*ldc;
+	for (size_t j = 0; j < n; ++j)
+		c_last_row[j] = T();
+	for (size_t p = 0; p < n; ++p) {
+		const T a_val = a[m*lda + p];
+		const T* b_row = b + p*ldb;
+		for (size_t j = 0; j < n; ++j)
+			c_last_row[j] += a_val*b_row[j];
+	}
+}
+
+// Strassen-Winograd with the two temporary schedule of Douglas et al.
+// Each level consumes 2*(n/2)^2 elements of work and passes the rest down.
+template<class T>
+void
+_multiply(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t n, size_t cutoff, T* work)
+{
+	if (n <= cutoff) {
+		impl_gemm::_gemm_kernel(a, lda, b, ldb, c, ldc, n, n, n);
+		return;
+	}
+
+	const size_t h = n / 2;
+	const T* a11 = a;
+	const T* a12 = a + h;
+	const T* a21 = a + h*lda;
+	const T* a22 = a21 + h;
+	const T* b11 = b;
+	const T* b12 = b + h;
+	const T* b21 = b + h*ldb;
+	const T* b22 = b21 + h;
+	T* c11 = c;
+	T* c12 = c + h;
+	T* c21 = c + h*ldc;
+	T* c22 = c21 + h;
+	T* x = work;
+	T* y = work + h*h;
+	T* next = y + h*h;
+
+	impl_strassen::_sub(a11, lda, a21, lda, x, h, h);
+	impl_strassen::_sub(b22, ldb, b12, ldb, y, h, h);
+	impl_strassen::_multiply(x, h, y, h, c21, ldc, h, cutoff, next);
+	impl_strassen::_add(a21, lda, a22, lda, x, h, h);
+	impl_strassen::_sub(b12, ldb, b11, ldb, y, h, h);
+	impl_strassen::_multiply(x, h, y, h, c22, ldc, h, cutoff, next);
+	impl_strassen::_sub(x, h, a11, lda, x, h, h);
+	impl_strassen::_sub(b22, ldb, y, h, y, h, h);
+	impl_strassen::_multiply(x, h, y, h, c12, ldc, h, cutoff, next);
+	impl_strassen::_sub(a12, lda, x, h, x, h, h);
+	impl_strassen::_multiply(x, h, b22, ldb, c11, ldc, h, cutoff, next);
+	impl_strassen::_multiply(a11, lda, b11, ldb, x, h, h, cutoff, next);
+	impl_strassen::_add(x, h, c12, ldc, c12, ldc, h);
+	impl_strassen::_add(c12, ldc, c21, ldc, c21, ldc, h);
+	impl_strassen::_add(c12, ldc, c22, ldc, c12, ldc, h);
+	impl_strassen::_add(c21, ldc, c22, ldc, c22, ldc, h);
+	impl_strassen::_add(c12, ldc, c11, ldc, c12, ldc, h);
+	impl_strassen::_sub(y, h, b21, ldb, y, h, h);
+	impl_strassen::_multiply(a22, lda, y, h, c11, ldc, h, cutoff, next);
+	impl_strassen::_sub(c21, ldc, c11, ldc, c21, ldc, h);
+	impl_strassen::_multiply(a12, lda, b21, ldb, c11, ldc, h, cutoff, next);
+	impl_strassen::_add(x, h, c11, ldc, c11, ldc, h);
+
+	if (n % 2)
+		impl_strassen::_peel(a, lda, b, ldb, c, ldc, n);
+}
+
+} // namespace impl_strassen
+
+
+
+template<class S>
+class strassen_workspace
+{
+public:
+	strassen_workspace() = default;
+
+	explicit
+	strassen_workspace(size_t order, size_t cutoff = strassen_default_cutoff) :
+		m_data(impl_strassen::_workspace_size(order, mtk::_max(cutoff, size_t(1))), for_overwrite)
+	{ }
+
+	void
+	reserve(size_t order, size_t cutoff = strassen_default_cutoff)
+	{
+		const size_t size = impl_strassen::_workspace_size(order, mtk::_max(cutoff, size_t(1)));
+		if (size > m_data.size())
+			m_data = array<S>(size, for_overwrite);
+	}
+
+	size_t
+	capacity() const
+	{
+		return m_data.size();
+	}
+
+	S*
+	data()
+	{
+		return m_data.data();
+	}
+
+private:
+	array<S> m_data;
+};
+
+
+
+template<class MatA
+	,class MatB
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename MatA::value_type, typename MatB::value_type>> = 0
+	,_require<(MatA::column_dimension == MatB::row_dimension)> = 0
+#endif
+>
+auto
+strassen_multiply(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs, strassen_workspace<typename MatA::value_type>& workspace, size_t cutoff = strassen_default_cutoff)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using value_type = typename MatA::value_type;
+	constexpr auto row_dim = MatA::row_dimension;
+	constexpr auto col_dim = MatB::column_dimension;
+	constexpr auto opt = MatA::options | MatB::options;
+	using ret_type1 = typename _linalg_traits<MatA>::template matrix_type<value_type, row_dim, col_dim, opt>;
+	using ret_type2 = typename _linalg_traits<MatB>::template matrix_type<value_type, row_dim, col_dim, opt>;
+	using mat_type = matrix<value_type, row_dim, col_dim, opt>;
+	using ret_type = std::conditional_t<std::is_same_v<ret_type1, mat_type>, ret_type2, ret_type1>;
+
+	const size_t rows = lhs.rows();
+	const size_t cols = rhs.columns();
+	const size_t depth = lhs.columns();
+	auto ret = mtk::_make_matrix_for_overwrite<ret_type>(rows, cols);
+	if (ret.empty())
+		return ret;
+
+	cutoff = mtk::_max(cutoff, size_t(1));
+	const bool use_strassen = (rows == cols) && (rows == depth) && (rows > cutoff);
+	if (use_strassen)
+		workspace.reserve(rows, cutoff);
+
+	array<value_type> lhs_buf;
+	array<value_type> rhs_buf;
+	if constexpr (impl_gemm::_has_contiguous_rows<ret_type>) {
+		const value_type* a = impl_gemm::_packed_rows(lhs, lhs_buf);
+		const value_type* b = impl_gemm::_packed_rows(rhs, rhs_buf);
+		if (use_strassen)
+			impl_strassen::_multiply(a, depth, b, cols, ret.begin(), cols, rows, cutoff, workspace.data());
+		else
+			impl_gemm::_gemm_kernel(a, depth, b, cols, ret.begin(), cols, rows, cols, depth);
+	} else if constexpr (impl_gemm::_has_contiguous_columns<ret_type>) {
+		const value_type* bt = impl_gemm::_packed_columns(rhs, rhs_buf);
+		const value_type* at = impl_gemm::_packed_columns(lhs, lhs_buf);
+		if (use_strassen)
+			impl_strassen::_multiply(bt, depth, at, rows, ret.begin(), rows, rows, cutoff, workspace.data());
+		else
+			impl_gemm::_gemm_kernel(bt, depth, at, rows, ret.begin(), rows, cols, rows, depth);
+	} else {
+		const value_type* a = impl_gemm::_packed_rows(lhs, lhs_buf);
+		const value_type* b = impl_gemm::_packed_rows(rhs, rhs_buf);
+		array<value_type> out(rows*cols, for_overwrite);
+		if (use_strassen)
+			impl_strassen::_multiply(a, depth, b, cols, out.data(), cols, rows, cutoff, workspace.data());
+		else
+			impl_gemm::_gemm_kernel(a, depth, b, cols, out.data(), cols, rows, cols, depth);
+
+		for (size_t row = 0; row < rows; ++row) {
+			for (size_t col = 0; col < cols; ++col)
+				ret.value(row, col) = out[row*cols + col];
+		}
+	}
+
+	return ret;
+}
+
+template<class MatA
+	,class MatB
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename MatA::value_type, typename MatB::value_type>> = 0
+	,_require<(MatA::column_dimension == MatB::row_dimension)> = 0
+#endif
+>
+auto
+strassen_multiply(const _matrix_base<MatA>& lhs, const _matrix_base<MatB>& rhs, size_t cutoff = strassen_default_cutoff)
+{
+	strassen_workspace<typename MatA::value_type> workspace;
+	return mtk::strassen_multiply(lhs, rhs, workspace, cutoff);
+}
+
+} // namespace mtk
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef MTK_LINALG_SYMMETRIC_HPP
+#define MTK_LINALG_SYMMETRIC_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/preprocessor.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <type_traits>
+
+namespace mtk {
+namespace impl_symmetric {
+
+constexpr
+size_t
+_packed_size(size_t size)
+{
+	return (size == dynamic_extent ? dynamic_extent : size*(size + 1) / 2);
+}
+
+} // namespace impl_symmetric
+
+
+
+// The upper triangle is packed column by column, so column c holds rows [0, c] contiguously.
+template<class Scalar
+	,size_t Size>
+class symmetric_matrix
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using storage_type = array<Scalar, impl_symmetric::_packed_size(Size)>;
+
+	static constexpr
+	size_type
+	row_dimension = Size;
+
+	static constexpr
+	size_type
+	column_dimension = Size;
+
+	constexpr
+	symmetric_matrix() :
+		m_data(),
+		m_size(Size == dynamic_extent ? 0 : Size)
+	{ }
+
+	template<size_t S = Size
+#ifndef MTK_DOXYGEN
+		,_require<(S == dynamic_extent)> = 0
+#endif
+	>
+	explicit
+	symmetric_matrix(size_type size) :
+		m_data(impl_symmetric::_packed_size(size)),
+		m_size(size)
+	{ }
+
+	// Only the upper triangle of m is read.
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+		,_require<(Mat::row_dimension == Size)> = 0
+		,_require<(Mat::column_dimension == Size)> = 0
+#endif
+	>
+	explicit
+	symmetric_matrix(const _matrix_base<Mat>& m) :
+		symmetric_matrix(symmetric_matrix::_make(m.rows()))
+	{
+		MTK_ASSERT(m.rows() == m.columns());
+
+		for (size_type col = 0; col < m_size; ++col) {
+			for (size_type row = 0; row <= col; ++row)
+				m_data[symmetric_matrix::_index(row, col)] = m.value(row, col);
+		}
+	}
+
+	constexpr
+	size_type
+	rows() const
+	{
+		return m_size;
+	}
+
+	constexpr
+	size_type
+	columns() const
+	{
+		return m_size;
+	}
+
+	constexpr
+	value_type&
+	value(size_type row, size_type col)
+	{
+		MTK_ASSERT((row < m_size) && (col < m_size));
+		return m_data[symmetric_matrix::_packed_index(row, col)];
+	}
+
+	constexpr
+	const value_type&
+	value(size_type row, size_type col) const
+	{
+		MTK_ASSERT((row < m_size) && (col < m_size));
+		return m_data[symmetric_matrix::_packed_index(row, col)];
+	}
+
+	constexpr
+	const storage_type&
+	packed() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr
+	auto
+	to_dense() const
+	{
+		auto ret = mtk::_make_matrix<matrix<value_type, Size, Size>>(m_size, m_size);
+		for (size_type col = 0; col < m_size; ++col) {
+			for (size_type row = 0; row <= col; ++row) {
+				const value_type val = m_data[symmetric_matrix::_index(row, col)];
+				ret.value(row, col) = val;
+				ret.value(col, row) = val;
+			}
+		}
+
+		return ret;
+	}
+
+	// SYRK, *this += alpha*a*transpose(a).
+	template<class Mat
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Mat::value_type, Scalar>> = 0
+		,_require<(Mat::row_dimension == Size)> = 0
+#endif
+	>
+	constexpr
+	symmetric_matrix&
+	rank_k_update(const _matrix_base<Mat>& a, value_type alpha = value_type(1))
+	{
+		MTK_ASSERT(a.rows() == m_size);
+
+		const size_type inner = a.columns();
+		for (size_type col = 0; col < m_size; ++col) {
+			for (size_type row = 0; row <= col; ++row) {
+				value_type sum = value_type();
+				for (size_type k = 0; k < inner; ++k)
+					sum += a.value(row, k)*a.value(col, k);
+
+				m_data[symmetric_matrix::_index(row, col)] += alpha*sum;
+			}
+		}
+
+		return *this;
+	}
+
+	constexpr
+	symmetric_matrix&
+	operator+=(const symmetric_matrix& rhs)
+	{
+		MTK_ASSERT(m_size == rhs.m_size);
+
+		const size_type count = m_data.size();
+		for (size_type i = 0; i < count; ++i)
+			m_data[i] += rhs.m_data[i];
+
+		return *this;
+	}
+
+	constexpr
+	symmetric_matrix&
+	operator-=(const symmetric_matrix& rhs)
+	{
+		MTK_ASSERT(m_size == rhs.m_size);
+
+		const size_type count = m_data.size();
+		for (size_type i = 0; i < count; ++i)
+			m_data[i] -= rhs.m_data[i];
+
+		return *this;
+	}
+
+	constexpr
+	symmetric_matrix&
+	operator*=(value_type rhs)
+	{
+		for (auto& el : m_data)
+			el *= rhs;
+
+		return *this;
+	}
+
+	static constexpr
+	size_type
+	_index(size_type row, size_type col)
+	{
+		return col*(col + 1) / 2 + row;
+	}
+
+	static constexpr
+	size_type
+	_packed_index(size_type row, size_type col)
+	{
+		return (row <= col ? symmetric_matrix::_index(row, col) : symmetric_matrix::_index(col, row));
+	}
+
+private:
+	static
+	symmetric_matrix
+	_make(size_type size)
+	{
+		MTK_IGNORE(size);
+		if constexpr (Size == dynamic_extent)
+			return symmetric_matrix(size);
+		else
+			return symmetric_matrix();
+	}
+
+	storage_type m_data;
+	size_type m_size;
+};
+
+
+
+template<class Scalar
+	,size_t Size>
+constexpr
+symmetric_matrix<Scalar, Size>
+operator+(symmetric_matrix<Scalar, Size> lhs, const symmetric_matrix<Scalar, Size>& rhs)
+{
+	return lhs += rhs;
+}
+
+template<class Scalar
+	,size_t Size>
+constexpr
+symmetric_matrix<Scalar, Size>
+operator-(symmetric_matrix<Scalar, Size> lhs, const symmetric_matrix<Scalar, Size>& rhs)
+{
+	return lhs -= rhs;
+}
+
+// SYMV/SYMM, each stored element contributes to both its own row and its mirror.
+template<class Scalar
+	,size_t Size
+	,class Mat
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<Scalar, typename Mat::value_type>> = 0
+	,_require<(Size == Mat::row_dimension)> = 0
+#endif
+>
+constexpr
+auto
+operator*(const symmetric_matrix<Scalar, Size>& lhs, const _matrix_base<Mat>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using ret_type = typename _linalg_traits<Mat>::template matrix_type<Scalar, Mat::row_dimension, Mat::column_dimension, Mat::options>;
+
+	const size_t size = lhs.rows();
+	const size_t cols = rhs.columns();
+	const auto& packed = lhs.packed();
+	auto ret = mtk::_make_matrix<ret_type>(size, cols);
+	for (size_t rcol = 0; rcol < cols; ++rcol) {
+		for (size_t col = 0; col < size; ++col) {
+			const Scalar* column = packed.data() + symmetric_matrix<Scalar, Size>::_index(0, col);
+			const Scalar x = rhs.value(col, rcol);
+			Scalar sum = Scalar();
+			for (size_t row = 0; row < col; ++row) {
+				ret.value(row, rcol) += column[row]*x;
+				sum += column[row]*rhs.value(row, rcol);
+			}
+
+			ret.value(col, rcol) += sum + column[col]*x;
+		}
+	}
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
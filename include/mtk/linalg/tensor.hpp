@@ -0,0 +1,836 @@
+#ifndef MTK_LINALG_TENSOR_HPP
+#define MTK_LINALG_TENSOR_HPP
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace mtk {
+namespace impl_tensor {
+
+template<size_t... Extents>
+inline constexpr size_t _static_size = ((Extents == dynamic_extent) || ...) ? dynamic_extent : (size_t(1) * ... * Extents);
+
+template<size_t... Extents>
+inline constexpr size_t _rank_dynamic = (size_t(0) + ... + size_t(Extents == dynamic_extent));
+
+// One trailing slot so rank 0 tensors do not need a zero sized array.
+template<size_t... Extents>
+inline constexpr size_t _static_extents[sizeof...(Extents) + 1] = {Extents..., 0};
+
+template<size_t N
+	,size_t... Extents>
+inline constexpr size_t _nth_extent = _static_extents<Extents...>[N];
+
+struct _extents_tag { };
+
+template<class Scalar
+	,size_t Axis
+	,class Seq
+	,size_t... Extents>
+struct _reduced_tensor;
+
+template<class Scalar
+	,size_t Axis
+	,size_t... Is
+	,size_t... Extents>
+struct _reduced_tensor<Scalar, Axis, std::index_sequence<Is...>, Extents...>
+{
+	using type = tensor<Scalar, _nth_extent<(Is < Axis ? Is : Is + 1), Extents...>...>;
+};
+
+
+
+// Maps the linear row-major index of a 2d view onto an arbitrarily strided region.
+template<class Iter>
+class _stride_iterator
+{
+public:
+	using value_type = iter::value_type<Iter>;
+	using reference = iter::reference<Iter>;
+	using pointer = iter::pointer<Iter>;
+	using difference_type = iter::difference_type<Iter>;
+	using iterator_category = std::random_access_iterator_tag;
+
+	constexpr
+	_stride_iterator() = default;
+
+	constexpr
+	_stride_iterator(Iter iter, size_t cols, size_t row_stride, size_t col_stride, size_t idx) :
+		m_iter(iter),
+		m_cols(cols),
+		m_row_stride(row_stride),
+		m_col_stride(col_stride),
+		m_idx(idx)
+	{ }
+
+	template<class OtherIt
+		,_require<std::is_convertible_v<OtherIt, Iter>> = 0>
+	constexpr
+	_stride_iterator(const _stride_iterator<OtherIt>& other) :
+		m_iter(other.m_iter),
+		m_cols(other.m_cols),
+		m_row_stride(other.m_row_stride),
+		m_col_stride(other.m_col_stride),
+		m_idx(other.m_idx)
+	{ }
+
+	constexpr
+	reference
+	operator*() const
+	{
+		return *this->_current();
+	}
+
+	constexpr
+	Iter
+	operator->() const
+	{
+		return this->_current();
+	}
+
+	constexpr
+	reference
+	operator[](difference_type idx) const
+	{
+		return *(*this + idx);
+	}
+
+	friend constexpr
+	_stride_iterator&
+	operator++(_stride_iterator& rhs)
+	{
+		++rhs.m_idx;
+		return rhs;
+	}
+
+	friend constexpr
+	_stride_iterator
+	operator++(_stride_iterator& lhs, int)
+	{
+		auto cp = lhs;
+		++lhs;
+		return cp;
+	}
+
+	friend constexpr
+	_stride_iterator&
+	operator--(_stride_iterator& rhs)
+	{
+		--rhs.m_idx;
+		return rhs;
+	}
+
+	friend constexpr
+	_stride_iterator
+	operator--(_stride_iterator& lhs, int)
+	{
+		auto cp = lhs;
+		--lhs;
+		return cp;
+	}
+
+	friend constexpr
+	_stride_iterator&
+	operator+=(_stride_iterator& lhs, difference_type rhs)
+	{
+		lhs.m_idx += rhs;
+		return lhs;
+	}
+
+	friend constexpr
+	_stride_iterator&
+	operator-=(_stride_iterator& lhs, difference_type rhs)
+	{
+		lhs.m_idx -= rhs;
+		return lhs;
+	}
+
+	friend constexpr
+	_stride_iterator
+	operator+(_stride_iterator lhs, difference_type rhs)
+	{
+		return (lhs += rhs);
+	}
+
+	friend constexpr
+	_stride_iterator
+	operator+(difference_type lhs, _stride_iterator rhs)
+	{
+		return (rhs += lhs);
+	}
+
+	friend constexpr
+	_stride_iterator
+	operator-(_stride_iterator lhs, difference_type rhs)
+	{
+		return (lhs -= rhs);
+	}
+
+	friend constexpr
+	difference_type
+	operator-(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return difference_type(lhs.m_idx) - difference_type(rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator==(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx == rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator!=(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx != rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator<(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx < rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator>(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx > rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator<=(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx <= rhs.m_idx);
+	}
+
+	friend constexpr
+	bool
+	operator>=(const _stride_iterator& lhs, const _stride_iterator& rhs)
+	{
+		return (lhs.m_idx >= rhs.m_idx);
+	}
+
+private:
+	constexpr
+	Iter
+	_current() const
+	{
+		return m_iter + (m_idx / m_cols)*m_row_stride + (m_idx % m_cols)*m_col_stride;
+	}
+
+	template<class OtherIter>
+	friend class _stride_iterator;
+
+	Iter m_iter;
+	size_t m_cols;
+	size_t m_row_stride;
+	size_t m_col_stride;
+	size_t m_idx;
+};
+
+
+
+template<class Iter
+	,class ConstIter
+	,size_t R
+	,size_t C
+	,bool IsConst = std::is_same_v<Iter, ConstIter>>
+class _matrix_view :
+	public _matrix_base_selector<_matrix_view<Iter, ConstIter, R, C, IsConst>>::type
+{
+public:
+	constexpr
+	_matrix_view(Iter iter, size_t rows, size_t cols) :
+		m_iter(iter),
+		m_rows(rows),
+		m_cols(cols)
+	{ }
+
+	auto operator=(const _matrix_view&) = delete;
+
+private:
+	friend struct _linalg_traits<_matrix_view>;
+	Iter m_iter;
+	size_t m_rows;
+	size_t m_cols;
+};
+
+template<class Iter
+	,class ConstIter
+	,size_t R
+	,size_t C>
+class _matrix_view<Iter, ConstIter, R, C, false> :
+	public _matrix_base_selector<_matrix_view<Iter, ConstIter, R, C, false>>::type
+{
+public:
+	constexpr
+	_matrix_view(Iter iter, size_t rows, size_t cols) :
+		m_iter(iter),
+		m_rows(rows),
+		m_cols(cols)
+	{ }
+
+	constexpr
+	_matrix_view&
+	operator=(const _matrix_view& other)
+	{
+		this->_assign_rows(other.begin_rows());
+		return *this;
+	}
+
+	template<class Other
+		,_require<_is_matrix_compatible<_matrix_view, Other>::value> = 0>
+	constexpr
+	_matrix_view&
+	operator=(const _matrix_base<Other>& other)
+	{
+		this->_assign_rows(other.begin_rows());
+		return *this;
+	}
+
+private:
+	friend struct _linalg_traits<_matrix_view>;
+	Iter m_iter;
+	size_t m_rows;
+	size_t m_cols;
+};
+
+} // namespace impl_tensor
+
+
+
+template<class Iter
+	,class ConstIter
+	,size_t R
+	,size_t C
+	,bool IsConst>
+struct _linalg_traits<impl_tensor::_matrix_view<Iter, ConstIter, R, C, IsConst>>
+{
+	using mat = impl_tensor::_matrix_view<Iter, ConstIter, R, C, IsConst>;
+
+	using value_type = iter::value_type<Iter>;
+	using iterator = Iter;
+	using const_iterator = ConstIter;
+
+	static constexpr size_t row_dimension = R;
+	static constexpr size_t column_dimension = C;
+	static constexpr matrix_options options = matrix_options::row_major;
+
+	template<class Scalar
+		,size_t Rows
+		,size_t Cols
+		,matrix_options Options>
+	using matrix_type = matrix<Scalar, Rows, Cols, Options>;
+
+	template<class Mat>
+	static constexpr
+	auto
+	begin(Mat&& m)
+	{
+		return m.m_iter;
+	}
+
+	template<class Mat>
+	static constexpr
+	auto
+	end(Mat&& m)
+	{
+		return m.m_iter + rows(m)*columns(m);
+	}
+
+	static constexpr
+	auto
+	rows(const mat& m)
+	{
+		if constexpr (R == dynamic_extent)
+			return m.m_rows;
+		else
+			return R;
+	}
+
+	static constexpr
+	auto
+	columns(const mat& m)
+	{
+		if constexpr (C == dynamic_extent)
+			return m.m_cols;
+		else
+			return C;
+	}
+};
+
+
+
+// Row-major, the last axis is contiguous.
+template<class Scalar
+	,size_t... Extents>
+class tensor
+{
+public:
+	using value_type = Scalar;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+	using iterator = pointer;
+	using const_iterator = const_pointer;
+
+	using storage_type = array<Scalar, impl_tensor::_static_size<Extents...>>;
+
+	static constexpr
+	size_type
+	rank() noexcept
+	{
+		return sizeof...(Extents);
+	}
+
+	static constexpr
+	size_type
+	rank_dynamic() noexcept
+	{
+		return impl_tensor::_rank_dynamic<Extents...>;
+	}
+
+	static constexpr
+	size_type
+	static_extent(size_type axis) noexcept
+	{
+		return impl_tensor::_static_extents<Extents...>[axis];
+	}
+
+	constexpr
+	tensor() :
+		m_extents(),
+		m_data()
+	{ }
+
+	template<class... Sizes
+#ifndef MTK_DOXYGEN
+		,_require<(sizeof...(Sizes) == impl_tensor::_rank_dynamic<Extents...>) && (sizeof...(Sizes) > 0)> = 0
+		,_require<(std::is_convertible_v<Sizes, size_type> && ...)> = 0
+#endif
+	>
+	explicit
+	tensor(Sizes... extents) :
+		m_extents{{static_cast<size_type>(extents)...}},
+		m_data(this->_product(0, rank()))
+	{ }
+
+	tensor(impl_tensor::_extents_tag, const size_type* extents) :
+		m_extents(),
+		m_data()
+	{
+		size_type dyn = 0;
+		for (size_type axis = 0; axis < rank(); ++axis) {
+			if (static_extent(axis) == dynamic_extent)
+				m_extents[dyn++] = extents[axis];
+			else
+				MTK_ASSERT(static_extent(axis) == extents[axis]);
+		}
+
+		if constexpr (rank_dynamic() > 0)
+			m_data = storage_type(this->_product(0, rank()));
+	}
+
+	constexpr
+	size_type
+	extent(size_type axis) const
+	{
+		MTK_ASSERT(axis < rank());
+		if (static_extent(axis) != dynamic_extent)
+			return static_extent(axis);
+
+		size_type dyn = 0;
+		for (size_type i = 0; i < axis; ++i)
+			dyn += (static_extent(i) == dynamic_extent);
+
+		return m_extents[dyn];
+	}
+
+	// Distance in elements between neighbours along axis.
+	constexpr
+	size_type
+	stride(size_type axis) const
+	{
+		MTK_ASSERT(axis < rank());
+		return this->_product(axis + 1, rank());
+	}
+
+	constexpr
+	size_type
+	size() const
+	{
+		return m_data.size();
+	}
+
+	[[nodiscard]]
+	constexpr
+	bool
+	empty() const
+	{
+		return (this->size() == 0);
+	}
+
+	constexpr
+	iterator
+	begin()
+	{
+		return m_data.begin();
+	}
+
+	constexpr
+	const_iterator
+	begin() const
+	{
+		return m_data.begin();
+	}
+
+	constexpr
+	iterator
+	end()
+	{
+		return m_data.end();
+	}
+
+	constexpr
+	const_iterator
+	end() const
+	{
+		return m_data.end();
+	}
+
+	constexpr
+	pointer
+	data()
+	{
+		return m_data.data();
+	}
+
+	constexpr
+	const_pointer
+	data() const
+	{
+		return m_data.data();
+	}
+
+	template<class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(sizeof...(Indices) == sizeof...(Extents))> = 0
+		,_require<(std::is_convertible_v<Indices, size_type> && ...)> = 0
+#endif
+	>
+	constexpr
+	reference
+	value(Indices... idx)
+	{
+		return m_data[this->_offset(static_cast<size_type>(idx)...)];
+	}
+
+	template<class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(sizeof...(Indices) == sizeof...(Extents))> = 0
+		,_require<(std::is_convertible_v<Indices, size_type> && ...)> = 0
+#endif
+	>
+	constexpr
+	const_reference
+	value(Indices... idx) const
+	{
+		return m_data[this->_offset(static_cast<size_type>(idx)...)];
+	}
+
+	template<class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(sizeof...(Indices) == sizeof...(Extents))> = 0
+		,_require<(std::is_convertible_v<Indices, size_type> && ...)> = 0
+#endif
+	>
+	constexpr
+	reference
+	operator()(Indices... idx)
+	{
+		return this->value(idx...);
+	}
+
+	template<class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(sizeof...(Indices) == sizeof...(Extents))> = 0
+		,_require<(std::is_convertible_v<Indices, size_type> && ...)> = 0
+#endif
+	>
+	constexpr
+	const_reference
+	operator()(Indices... idx) const
+	{
+		return this->value(idx...);
+	}
+
+	// Matrix view over axes RowAxis and ColAxis, idx fixes the remaining axes in order.
+	template<size_t RowAxis
+		,size_t ColAxis
+		,class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(RowAxis < sizeof...(Extents)) && (ColAxis < sizeof...(Extents)) && (RowAxis != ColAxis)> = 0
+		,_require<(sizeof...(Indices) + 2 == sizeof...(Extents))> = 0
+#endif
+	>
+	auto
+	matrix_view(Indices... idx)
+	{
+		using iter_type = impl_tensor::_stride_iterator<pointer>;
+		using const_iter_type = impl_tensor::_stride_iterator<const_pointer>;
+		using view_type = impl_tensor::_matrix_view<iter_type, const_iter_type, impl_tensor::_nth_extent<RowAxis, Extents...>, impl_tensor::_nth_extent<ColAxis, Extents...>>;
+
+		const size_type offset = this->_view_offset(RowAxis, ColAxis, {static_cast<size_type>(idx)...});
+		const size_type cols = this->extent(ColAxis);
+		auto it = iter_type(this->data() + offset, cols, this->stride(RowAxis), this->stride(ColAxis), 0);
+		return view_type(it, this->extent(RowAxis), cols);
+	}
+
+	template<size_t RowAxis
+		,size_t ColAxis
+		,class... Indices
+#ifndef MTK_DOXYGEN
+		,_require<(RowAxis < sizeof...(Extents)) && (ColAxis < sizeof...(Extents)) && (RowAxis != ColAxis)> = 0
+		,_require<(sizeof...(Indices) + 2 == sizeof...(Extents))> = 0
+#endif
+	>
+	auto
+	matrix_view(Indices... idx) const
+	{
+		using iter_type = impl_tensor::_stride_iterator<const_pointer>;
+		using view_type = impl_tensor::_matrix_view<iter_type, iter_type, impl_tensor::_nth_extent<RowAxis, Extents...>, impl_tensor::_nth_extent<ColAxis, Extents...>>;
+
+		const size_type offset = this->_view_offset(RowAxis, ColAxis, {static_cast<size_type>(idx)...});
+		const size_type cols = this->extent(ColAxis);
+		auto it = iter_type(this->data() + offset, cols, this->stride(RowAxis), this->stride(ColAxis), 0);
+		return view_type(it, this->extent(RowAxis), cols);
+	}
+
+	// Folds axis Axis away, every output element starts at init.
+	template<size_t Axis
+		,class BinaryOp
+#ifndef MTK_DOXYGEN
+		,_require<(Axis < sizeof...(Extents))> = 0
+#endif
+	>
+	auto
+	reduce(value_type init, BinaryOp op) const
+	{
+		using ret_type = typename impl_tensor::_reduced_tensor<Scalar, Axis, std::make_index_sequence<sizeof...(Extents) - 1>, Extents...>::type;
+
+		size_type extents[rank()] = { };
+		for (size_type axis = 0; axis + 1 < rank(); ++axis)
+			extents[axis] = this->extent(axis < Axis ? axis : axis + 1);
+
+		ret_type ret(impl_tensor::_extents_tag(), extents);
+		for (auto& el : ret)
+			el = init;
+
+		const size_type outer = this->_product(0, Axis);
+		const size_type len = this->extent(Axis);
+		const size_type inner = this->stride(Axis);
+		const value_type* src = this->data();
+		value_type* dst = ret.data();
+		for (size_type o = 0; o < outer; ++o) {
+			value_type* out = dst + o*inner;
+			for (size_type a = 0; a < len; ++a) {
+				const value_type* in = src + (o*len + a)*inner;
+				for (size_type i = 0; i < inner; ++i)
+					out[i] = op(out[i], in[i]);
+			}
+		}
+
+		return ret;
+	}
+
+	template<size_t Axis
+#ifndef MTK_DOXYGEN
+		,_require<(Axis < sizeof...(Extents))> = 0
+#endif
+	>
+	auto
+	sum() const
+	{
+		return this->template reduce<Axis>(value_type(), [](value_type lhs, value_type rhs) { return lhs + rhs; });
+	}
+
+	tensor&
+	operator+=(const tensor& rhs)
+	{
+		MTK_ASSERT(this->_same_extents(rhs));
+
+		const size_type count = this->size();
+		for (size_type i = 0; i < count; ++i)
+			m_data[i] += rhs.m_data[i];
+
+		return *this;
+	}
+
+	tensor&
+	operator-=(const tensor& rhs)
+	{
+		MTK_ASSERT(this->_same_extents(rhs));
+
+		const size_type count = this->size();
+		for (size_type i = 0; i < count; ++i)
+			m_data[i] -= rhs.m_data[i];
+
+		return *this;
+	}
+
+	tensor&
+	operator*=(value_type rhs)
+	{
+		for (auto& el : m_data)
+			el *= rhs;
+
+		return *this;
+	}
+
+	tensor&
+	operator/=(value_type rhs)
+	{
+		for (auto& el : m_data)
+			el /= rhs;
+
+		return *this;
+	}
+
+private:
+	constexpr
+	size_type
+	_product(size_type first, size_type last) const
+	{
+		size_type ret = 1;
+		for (size_type axis = first; axis < last; ++axis)
+			ret *= this->extent(axis);
+
+		return ret;
+	}
+
+	template<class... Indices>
+	constexpr
+	size_type
+	_offset(Indices... idx) const
+	{
+		size_type ret = 0;
+		size_type axis = 0;
+		((ret = this->_offset_step(ret, axis++, idx)), ...);
+		return ret;
+	}
+
+	constexpr
+	size_type
+	_offset_step(size_type offset, size_type axis, size_type idx) const
+	{
+		const size_type ext = this->extent(axis);
+		MTK_ASSERT(idx < ext);
+		return offset*ext + idx;
+	}
+
+	constexpr
+	size_type
+	_view_offset(size_type row_axis, size_type col_axis, std::initializer_list<size_type> idx) const
+	{
+		size_type ret = 0;
+		auto it = idx.begin();
+		for (size_type axis = 0; axis < rank(); ++axis) {
+			if ((axis == row_axis) || (axis == col_axis))
+				continue;
+
+			MTK_ASSERT(*it < this->extent(axis));
+			ret += *(it++)*this->stride(axis);
+		}
+
+		return ret;
+	}
+
+	constexpr
+	bool
+	_same_extents(const tensor& other) const
+	{
+		for (size_type axis = 0; axis < rank(); ++axis) {
+			if (this->extent(axis) != other.extent(axis))
+				return false;
+		}
+
+		return true;
+	}
+
+	array<size_type, (impl_tensor::_rank_dynamic<Extents...> > 0 ? impl_tensor::_rank_dynamic<Extents...> : 1)> m_extents;
+	storage_type m_data;
+};
+
+
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator-(tensor<Scalar, Extents...> rhs)
+{
+	for (auto& el : rhs)
+		el = -el;
+
+	return rhs;
+}
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator+(tensor<Scalar, Extents...> lhs, const tensor<Scalar, Extents...>& rhs)
+{
+	return (lhs += rhs);
+}
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator-(tensor<Scalar, Extents...> lhs, const tensor<Scalar, Extents...>& rhs)
+{
+	return (lhs -= rhs);
+}
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator*(tensor<Scalar, Extents...> lhs, Scalar rhs)
+{
+	return (lhs *= rhs);
+}
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator*(Scalar lhs, tensor<Scalar, Extents...> rhs)
+{
+	return (rhs *= lhs);
+}
+
+template<class Scalar
+	,size_t... Extents>
+tensor<Scalar, Extents...>
+operator/(tensor<Scalar, Extents...> lhs, Scalar rhs)
+{
+	return (lhs /= rhs);
+}
+
+} // namespace mtk
+
+#endif
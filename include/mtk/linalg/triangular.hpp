@@ -0,0 +1,195 @@
+#ifndef MTK_LINALG_TRIANGULAR_HPP
+#define MTK_LINALG_TRIANGULAR_HPP
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+#include <mtk/core/impl/require.hpp>
+#include <mtk/linalg/fwd.hpp>
+#include <mtk/linalg/matrix.hpp>
+
+#include <type_traits>
+
+namespace mtk {
+
+template<class Mat
+	,triangular_options Options>
+class triangular_view
+{
+public:
+	using value_type = typename Mat::value_type;
+	using size_type = size_t;
+
+	static constexpr
+	size_type
+	row_dimension = Mat::row_dimension;
+
+	static constexpr
+	size_type
+	column_dimension = Mat::column_dimension;
+
+	static constexpr
+	triangular_options
+	options = Options;
+
+	static constexpr
+	bool
+	_is_upper = ((Options & triangular_options::upper) == triangular_options::upper);
+
+	static constexpr
+	bool
+	_is_unit = ((Options & triangular_options::unit_diagonal) == triangular_options::unit_diagonal);
+
+	static_assert(Mat::row_dimension == Mat::column_dimension, "Mat must be square");
+
+	explicit constexpr
+	triangular_view(const _matrix_base<Mat>& m) :
+		m_mat(&static_cast<const Mat&>(m))
+	{
+		MTK_ASSERT(m.rows() == m.columns());
+	}
+
+	constexpr
+	size_type
+	rows() const
+	{
+		return m_mat->rows();
+	}
+
+	constexpr
+	size_type
+	columns() const
+	{
+		return m_mat->columns();
+	}
+
+	constexpr
+	value_type
+	value(size_type row, size_type col) const
+	{
+		if (row == col)
+			return (_is_unit ? value_type(1) : m_mat->value(row, col));
+
+		const bool inside = (_is_upper ? (col > row) : (col < row));
+		return (inside ? m_mat->value(row, col) : value_type());
+	}
+
+	constexpr
+	auto
+	to_dense() const
+	{
+		using ret_type = typename _linalg_traits<Mat>::template matrix_type<value_type, row_dimension, column_dimension, Mat::options>;
+
+		const auto size = this->rows();
+		auto ret = mtk::_make_matrix<ret_type>(size, size);
+		for (size_type row = 0; row < size; ++row) {
+			for (size_type col = 0; col < size; ++col)
+				ret.value(row, col) = this->value(row, col);
+		}
+
+		return ret;
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, value_type>> = 0
+#endif
+	>
+	constexpr
+	void
+	solve_in_place(_matrix_base<Other>& rhs) const
+	{
+		MTK_ASSERT(rhs.rows() == this->rows());
+
+		const auto size = this->rows();
+		const auto cols = rhs.columns();
+		for (size_type n = 0; n < size; ++n) {
+			const size_type row = (_is_upper ? size - 1 - n : n);
+			const size_type first = (_is_upper ? row + 1 : 0);
+			const size_type last = (_is_upper ? size : row);
+			for (size_type k = first; k < last; ++k) {
+				const value_type factor = m_mat->value(row, k);
+				if (factor == value_type())
+					continue;
+
+				for (size_type col = 0; col < cols; ++col)
+					rhs.value(row, col) -= factor*rhs.value(k, col);
+			}
+
+			if constexpr (!_is_unit) {
+				const value_type diag = m_mat->value(row, row);
+				for (size_type col = 0; col < cols; ++col)
+					rhs.value(row, col) /= diag;
+			}
+		}
+	}
+
+	template<class Other
+#ifndef MTK_DOXYGEN
+		,_require<std::is_same_v<typename Other::value_type, value_type>> = 0
+#endif
+	>
+	constexpr
+	auto
+	solve(const _matrix_base<Other>& rhs) const
+	{
+		using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, Other::row_dimension, Other::column_dimension, Other::options>;
+
+		ret_type ret(rhs);
+		this->solve_in_place(ret);
+		return ret;
+	}
+
+private:
+	const Mat* m_mat;
+};
+
+template<triangular_options Options
+	,class Mat>
+constexpr
+triangular_view<Mat, Options>
+make_triangular_view(const _matrix_base<Mat>& m)
+{
+	return triangular_view<Mat, Options>(m);
+}
+
+
+
+template<class Mat
+	,triangular_options Options
+	,class Other
+#ifndef MTK_DOXYGEN
+	,_require<std::is_same_v<typename Mat::value_type, typename Other::value_type>> = 0
+	,_require<(Mat::column_dimension == Other::row_dimension)> = 0
+#endif
+>
+constexpr
+auto
+operator*(const triangular_view<Mat, Options>& lhs, const _matrix_base<Other>& rhs)
+{
+	MTK_ASSERT(lhs.columns() == rhs.rows());
+
+	using value_type = typename Mat::value_type;
+	using ret_type = typename _linalg_traits<Other>::template matrix_type<value_type, Mat::row_dimension, Other::column_dimension, Other::options>;
+	constexpr bool is_upper = triangular_view<Mat, Options>::_is_upper;
+
+	const size_t size = lhs.rows();
+	const size_t cols = rhs.columns();
+	auto ret = mtk::_make_matrix<ret_type>(size, cols);
+	for (size_t row = 0; row < size; ++row) {
+		const size_t first = (is_upper ? row : 0);
+		const size_t last = (is_upper ? size : row + 1);
+		for (size_t col = 0; col < cols; ++col) {
+			value_type sum = value_type();
+			for (size_t k = first; k < last; ++k)
+				sum += lhs.value(row, k)*rhs.value(k, col);
+
+			ret.value(row, col) = sum;
+		}
+	}
+
+	return ret;
+}
+
+} // namespace mtk
+
+#endif
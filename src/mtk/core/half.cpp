@@ -0,0 +1,220 @@
+#include <mtk/core/half.hpp>
+
+#include <mtk/core/assert.hpp>
+
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define MTK_IMPL_HALF_X86
+	#include <immintrin.h>
+#endif
+
+namespace mtk {
+namespace impl_core {
+namespace half {
+namespace {
+
+using _to_float_fn = void(*)(const std::uint16_t*, float*, size_t);
+using _from_float_fn = void(*)(const float*, std::uint16_t*, size_t);
+
+void
+_half_to_float_scalar(const std::uint16_t* src, float* dst, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = _half_bits_to_float(src[i]);
+}
+
+void
+_float_to_half_scalar(const float* src, std::uint16_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = _float_to_half_bits(src[i]);
+}
+
+void
+_bfloat16_to_float_scalar(const std::uint16_t* src, float* dst, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = _bfloat16_bits_to_float(src[i]);
+}
+
+void
+_float_to_bfloat16_scalar(const float* src, std::uint16_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = _float_to_bfloat16_bits(src[i]);
+}
+
+#ifdef MTK_IMPL_HALF_X86
+
+__attribute__((target("avx,f16c")))
+void
+_half_to_float_f16c(const std::uint16_t* src, float* dst, size_t n)
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+	}
+	_half_to_float_scalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx,f16c")))
+void
+_float_to_half_f16c(const float* src, std::uint16_t* dst, size_t n)
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+	}
+	_float_to_half_scalar(src + i, dst + i, n - i);
+}
+
+// The zero masked forms with all lanes set, GCC 12 warns about the undefined
+// pass-through operand of the unmasked intrinsics.
+__attribute__((target("avx512f")))
+void
+_half_to_float_avx512(const std::uint16_t* src, float* dst, size_t n)
+{
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm512_storeu_ps(dst + i, _mm512_maskz_cvtph_ps(0xFFFF, h));
+	}
+	_half_to_float_scalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void
+_float_to_half_avx512(const float* src, std::uint16_t* dst, size_t n)
+{
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m256i h = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), h);
+	}
+	_float_to_half_scalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void
+_bfloat16_to_float_avx2(const std::uint16_t* src, float* dst, size_t n)
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m256i f = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+		_mm256_storeu_ps(dst + i, _mm256_castsi256_ps(f));
+	}
+	_bfloat16_to_float_scalar(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void
+_float_to_bfloat16_avx2(const float* src, std::uint16_t* dst, size_t n)
+{
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i bias = _mm256_set1_epi32(0x7FFF);
+	const __m256i quiet = _mm256_set1_epi32(0x0040);
+
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256 v = _mm256_loadu_ps(src + i);
+		const __m256i f = _mm256_castps_si256(v);
+		const __m256i upper = _mm256_srli_epi32(f, 16);
+		const __m256i lsb = _mm256_and_si256(upper, one);
+		const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(f, _mm256_add_epi32(bias, lsb)), 16);
+		const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+		const __m256i res = _mm256_blendv_epi8(rounded, _mm256_or_si256(upper, quiet), nan);
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0x08);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+	}
+	_float_to_bfloat16_scalar(src + i, dst + i, n - i);
+}
+
+#endif
+
+_to_float_fn
+_select_half_to_float()
+{
+#ifdef MTK_IMPL_HALF_X86
+	if (__builtin_cpu_supports("avx512f"))
+		return &_half_to_float_avx512;
+	if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+		return &_half_to_float_f16c;
+#endif
+	return &_half_to_float_scalar;
+}
+
+_from_float_fn
+_select_float_to_half()
+{
+#ifdef MTK_IMPL_HALF_X86
+	if (__builtin_cpu_supports("avx512f"))
+		return &_float_to_half_avx512;
+	if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+		return &_float_to_half_f16c;
+#endif
+	return &_float_to_half_scalar;
+}
+
+_to_float_fn
+_select_bfloat16_to_float()
+{
+#ifdef MTK_IMPL_HALF_X86
+	if (__builtin_cpu_supports("avx2"))
+		return &_bfloat16_to_float_avx2;
+#endif
+	return &_bfloat16_to_float_scalar;
+}
+
+_from_float_fn
+_select_float_to_bfloat16()
+{
+#ifdef MTK_IMPL_HALF_X86
+	if (__builtin_cpu_supports("avx2"))
+		return &_float_to_bfloat16_avx2;
+#endif
+	return &_float_to_bfloat16_scalar;
+}
+
+} // namespace
+} // namespace half
+} // namespace impl_core
+
+
+
+void
+convert(span<const half> src, span<float> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	static const auto fn = impl_core::half::_select_half_to_float();
+	fn(reinterpret_cast<const std::uint16_t*>(src.data()), dst.data(), src.size());
+}
+
+void
+convert(span<const float> src, span<half> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	static const auto fn = impl_core::half::_select_float_to_half();
+	fn(src.data(), reinterpret_cast<std::uint16_t*>(dst.data()), src.size());
+}
+
+void
+convert(span<const bfloat16> src, span<float> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	static const auto fn = impl_core::half::_select_bfloat16_to_float();
+	fn(reinterpret_cast<const std::uint16_t*>(src.data()), dst.data(), src.size());
+}
+
+void
+convert(span<const float> src, span<bfloat16> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	static const auto fn = impl_core::half::_select_float_to_bfloat16();
+	fn(src.data(), reinterpret_cast<std::uint16_t*>(dst.data()), src.size());
+}
+
+} // namespace mtk
@@ -0,0 +1,91 @@
+#include <mtk/core/memory_placement.hpp>
+
+#include <mtk/core/os.hpp>
+#include <mtk/core/preprocessor.hpp>
+
+#if defined(MTK_OS_LINUX) || defined(MTK_OS_ANDROID)
+	#define MTK_IMPL_MEMORY_MBIND
+	#include <sys/syscall.h>
+	#include <unistd.h>
+
+	#include <cstdio>
+#endif
+
+namespace mtk {
+namespace impl_core {
+namespace memory {
+namespace {
+
+#ifdef MTK_IMPL_MEMORY_MBIND
+
+// From <linux/mempolicy.h>, libnuma is not required.
+constexpr int _mpol_interleave = 3;
+
+constexpr size_t _max_nodes = 1024;
+constexpr size_t _mask_bits = 8*sizeof(unsigned long);
+
+struct _node_mask
+{
+	unsigned long bits[_max_nodes / _mask_bits];
+	size_t count;
+};
+
+// Parses /sys/devices/system/node/online, a list of ranges such as "0-3,8".
+_node_mask
+_read_online_nodes() noexcept
+{
+	_node_mask ret = { };
+	std::FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+	if (!file)
+		return ret;
+
+	unsigned first;
+	while (std::fscanf(file, "%u", &first) == 1) {
+		unsigned last = first;
+		int sep = std::fgetc(file);
+		if (sep == '-') {
+			if (std::fscanf(file, "%u", &last) != 1)
+				break;
+			sep = std::fgetc(file);
+		}
+
+		for (unsigned node = first; (node <= last) && (node < _max_nodes); ++node) {
+			ret.bits[node / _mask_bits] |= 1ul << (node % _mask_bits);
+			++ret.count;
+		}
+
+		if (sep != ',')
+			break;
+	}
+
+	std::fclose(file);
+	return ret;
+}
+
+#endif
+
+} // namespace
+
+void
+_interleave(void* ptr, size_t bytes) noexcept
+{
+#ifdef MTK_IMPL_MEMORY_MBIND
+	static const _node_mask nodes = _read_online_nodes();
+	static const size_t page = size_t(sysconf(_SC_PAGESIZE));
+	if ((nodes.count < 2) || (page == 0) || (page == size_t(-1)))
+		return;
+
+	const uintptr_t first = (reinterpret_cast<uintptr_t>(ptr) + page - 1) / page*page;
+	const uintptr_t last = (reinterpret_cast<uintptr_t>(ptr) + bytes) / page*page;
+	if (last <= first)
+		return;
+
+	syscall(SYS_mbind, first, last - first, _mpol_interleave, nodes.bits, _max_nodes + 1, 0u);
+#else
+	MTK_IGNORE(ptr, bytes);
+#endif
+}
+
+} // namespace memory
+} // namespace impl_core
+} // namespace mtk
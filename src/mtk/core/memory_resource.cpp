@@ -0,0 +1,44 @@
+#include <mtk/core/memory_resource.hpp>
+
+#include <new>
+
+namespace mtk {
+namespace impl_core {
+namespace memory {
+namespace {
+
+class _new_delete_resource final :
+	public memory_resource
+{
+protected:
+	void*
+	do_allocate(size_t bytes, size_t alignment) override
+	{
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			return ::operator new(bytes, std::align_val_t(alignment));
+
+		return ::operator new(bytes);
+	}
+
+	void
+	do_deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override
+	{
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			::operator delete(ptr, bytes, std::align_val_t(alignment));
+		else
+			::operator delete(ptr, bytes);
+	}
+};
+
+} // namespace
+} // namespace memory
+} // namespace impl_core
+
+memory_resource*
+new_delete_resource() noexcept
+{
+	static impl_core::memory::_new_delete_resource resource;
+	return &resource;
+}
+
+} // namespace mtk
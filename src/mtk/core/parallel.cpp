@@ -0,0 +1,67 @@
+#include <mtk/core/impl/parallel.hpp>
+
+#include <mtk/core/array.hpp>
+#include <mtk/core/impl/clamp.hpp>
+
+#include <exception>
+#include <thread>
+
+namespace mtk {
+namespace impl_core {
+namespace parallel {
+
+size_t
+_thread_count() noexcept
+{
+	static const size_t count = mtk::_max(size_t(std::thread::hardware_concurrency()), size_t(1));
+	return count;
+}
+
+void
+_run(size_t count, size_t grain, _range_fn fn, void* ctx)
+{
+	if (count == 0)
+		return;
+
+	grain = mtk::_max(grain, size_t(1));
+	const size_t chunks = mtk::_min(_thread_count(), (count + grain - 1) / grain);
+	if (chunks <= 1) {
+		fn(ctx, 0, count);
+		return;
+	}
+
+	// Every started thread is joined before leaving, the first exception in chunk order is rethrown.
+	mtk::array<std::exception_ptr> errors(chunks);
+	mtk::array<std::thread> threads(chunks - 1);
+	const auto run_chunk = [&](size_t i) noexcept {
+		try {
+			fn(ctx, i*count / chunks, (i + 1)*count / chunks);
+		} catch (...) {
+			errors[i] = std::current_exception();
+		}
+	};
+
+	try {
+		for (size_t i = 1; i < chunks; ++i)
+			threads[i - 1] = std::thread(run_chunk, i);
+	} catch (...) {
+		errors[0] = std::current_exception();
+	}
+
+	if (!errors[0])
+		run_chunk(0);
+
+	for (auto& t : threads) {
+		if (t.joinable())
+			t.join();
+	}
+
+	for (const auto& e : errors) {
+		if (e)
+			std::rethrow_exception(e);
+	}
+}
+
+} // namespace parallel
+} // namespace impl_core
+} // namespace mtk
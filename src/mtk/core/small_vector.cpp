@@ -0,0 +1,19 @@
+#include <mtk/core/small_vector.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace mtk {
+namespace impl_core {
+namespace small_vector {
+
+void _throw_out_of_range_exception(size_t idx, size_t size)
+{
+	char buf[512];
+	std::snprintf(buf, sizeof(buf), "mtk::small_vector::at index out of range (index: %zu, size: %zu)", idx, size);
+	throw std::out_of_range(buf);
+}
+
+} // namespace small_vector
+} // namespace impl_core
+} // namespace mtk
@@ -0,0 +1,83 @@
+#include <mtk/linalg/convolve.hpp>
+
+#include <mtk/core/types.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define MTK_IMPL_CONVOLVE_X86
+	#include <immintrin.h>
+#endif
+
+namespace mtk {
+namespace impl_convolve {
+namespace {
+
+using _axpy_f32_fn = void(*)(float, const float*, float*, size_t);
+
+void
+_axpy_f32_scalar(float a, const float* x, float* y, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+		y[i] += a*x[i];
+}
+
+#ifdef MTK_IMPL_CONVOLVE_X86
+
+__attribute__((target("sse2")))
+void
+_axpy_f32_sse2(float a, const float* x, float* y, size_t n)
+{
+	const __m128 va = _mm_set1_ps(a);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128 prod = _mm_mul_ps(va, _mm_loadu_ps(x + i));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), prod));
+	}
+
+	_axpy_f32_scalar(a, x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+void
+_axpy_f32_avx2(float a, const float* x, float* y, size_t n)
+{
+	const __m256 va = _mm256_set1_ps(a);
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m256 y0 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+		const __m256 y1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8));
+		_mm256_storeu_ps(y + i, y0);
+		_mm256_storeu_ps(y + i + 8, y1);
+	}
+	for (; i + 8 <= n; i += 8)
+		_mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+
+	_axpy_f32_scalar(a, x + i, y + i, n - i);
+}
+
+#endif
+
+_axpy_f32_fn
+_select_axpy_f32()
+{
+#ifdef MTK_IMPL_CONVOLVE_X86
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return &_axpy_f32_avx2;
+	if (__builtin_cpu_supports("sse2"))
+		return &_axpy_f32_sse2;
+#endif
+	return &_axpy_f32_scalar;
+}
+
+} // namespace
+
+
+
+void
+_axpy(float a, const float* x, float* y, size_t n)
+{
+	static const auto fn = _select_axpy_f32();
+	fn(a, x, y, n);
+}
+
+} // namespace impl_convolve
+} // namespace mtk
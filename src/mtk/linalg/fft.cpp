@@ -0,0 +1,237 @@
+#include <mtk/linalg/fft.hpp>
+
+#include <mtk/core/types.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define MTK_IMPL_FFT_X86
+	#include <immintrin.h>
+#endif
+
+namespace mtk {
+namespace impl_fft {
+namespace {
+
+template<class T>
+using _butterfly_fn = void(*)(const std::complex<T>*, std::complex<T>*, const std::complex<T>*, size_t, size_t);
+
+#ifdef MTK_IMPL_FFT_X86
+
+// The vector kernels run s interleaved transforms side by side, so every lane shares the twiddle.
+// Complex values stay interleaved, a*w is fmaddsub(a, re(w), swap(a)*im(w)).
+
+__attribute__((target("avx2,fma")))
+inline
+__m256d
+_mul_f64(__m256d a, __m256d w_re, __m256d w_im)
+{
+	return _mm256_fmaddsub_pd(a, w_re, _mm256_mul_pd(_mm256_permute_pd(a, 0x5), w_im));
+}
+
+__attribute__((target("avx2,fma")))
+inline
+__m256d
+_mul_neg_i_f64(__m256d a)
+{
+	return _mm256_xor_pd(_mm256_permute_pd(a, 0x5), _mm256_set_pd(-0.0, 0.0, -0.0, 0.0));
+}
+
+__attribute__((target("avx2,fma")))
+inline
+__m256
+_mul_f32(__m256 a, __m256 w_re, __m256 w_im)
+{
+	return _mm256_fmaddsub_ps(a, w_re, _mm256_mul_ps(_mm256_permute_ps(a, 0xb1), w_im));
+}
+
+__attribute__((target("avx2,fma")))
+inline
+__m256
+_mul_neg_i_f32(__m256 a)
+{
+	return _mm256_xor_ps(_mm256_permute_ps(a, 0xb1), _mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f));
+}
+
+__attribute__((target("avx2,fma")))
+void
+_butterfly2_f64_avx2(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s)
+{
+	if (s % 2 != 0)
+		return impl_fft::_butterfly2<double>(x, y, w, m, s);
+
+	const double* src = reinterpret_cast<const double*>(x);
+	double* dst = reinterpret_cast<double*>(y);
+	for (size_t p = 0; p < m; ++p) {
+		const __m256d w1_re = _mm256_set1_pd(w[p].real());
+		const __m256d w1_im = _mm256_set1_pd(w[p].imag());
+		const double* x0 = src + 2*s*p;
+		const double* x1 = src + 2*s*(p + m);
+		double* y0 = dst + 2*s*(2*p);
+		double* y1 = dst + 2*s*(2*p + 1);
+		for (size_t q = 0; q < 2*s; q += 4) {
+			const __m256d a0 = _mm256_loadu_pd(x0 + q);
+			const __m256d a1 = _mm256_loadu_pd(x1 + q);
+			_mm256_storeu_pd(y0 + q, _mm256_add_pd(a0, a1));
+			_mm256_storeu_pd(y1 + q, _mul_f64(_mm256_sub_pd(a0, a1), w1_re, w1_im));
+		}
+	}
+}
+
+__attribute__((target("avx2,fma")))
+void
+_butterfly2_f32_avx2(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s)
+{
+	if (s % 4 != 0)
+		return impl_fft::_butterfly2<float>(x, y, w, m, s);
+
+	const float* src = reinterpret_cast<const float*>(x);
+	float* dst = reinterpret_cast<float*>(y);
+	for (size_t p = 0; p < m; ++p) {
+		const __m256 w1_re = _mm256_set1_ps(w[p].real());
+		const __m256 w1_im = _mm256_set1_ps(w[p].imag());
+		const float* x0 = src + 2*s*p;
+		const float* x1 = src + 2*s*(p + m);
+		float* y0 = dst + 2*s*(2*p);
+		float* y1 = dst + 2*s*(2*p + 1);
+		for (size_t q = 0; q < 2*s; q += 8) {
+			const __m256 a0 = _mm256_loadu_ps(x0 + q);
+			const __m256 a1 = _mm256_loadu_ps(x1 + q);
+			_mm256_storeu_ps(y0 + q, _mm256_add_ps(a0, a1));
+			_mm256_storeu_ps(y1 + q, _mul_f32(_mm256_sub_ps(a0, a1), w1_re, w1_im));
+		}
+	}
+}
+
+__attribute__((target("avx2,fma")))
+void
+_butterfly4_f64_avx2(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s)
+{
+	if (s % 2 != 0)
+		return impl_fft::_butterfly4<double>(x, y, w, m, s);
+
+	const double* src = reinterpret_cast<const double*>(x);
+	double* dst = reinterpret_cast<double*>(y);
+	for (size_t p = 0; p < m; ++p) {
+		const __m256d w1_re = _mm256_set1_pd(w[p].real());
+		const __m256d w1_im = _mm256_set1_pd(w[p].imag());
+		const __m256d w2_re = _mm256_set1_pd(w[m + p].real());
+		const __m256d w2_im = _mm256_set1_pd(w[m + p].imag());
+		const __m256d w3_re = _mm256_set1_pd(w[2*m + p].real());
+		const __m256d w3_im = _mm256_set1_pd(w[2*m + p].imag());
+		const double* x0 = src + 2*s*p;
+		const double* x1 = src + 2*s*(p + m);
+		const double* x2 = src + 2*s*(p + 2*m);
+		const double* x3 = src + 2*s*(p + 3*m);
+		double* y0 = dst + 2*s*(4*p);
+		for (size_t q = 0; q < 2*s; q += 4) {
+			const __m256d a0 = _mm256_loadu_pd(x0 + q);
+			const __m256d a1 = _mm256_loadu_pd(x1 + q);
+			const __m256d a2 = _mm256_loadu_pd(x2 + q);
+			const __m256d a3 = _mm256_loadu_pd(x3 + q);
+			const __m256d t0 = _mm256_add_pd(a0, a2);
+			const __m256d t1 = _mm256_sub_pd(a0, a2);
+			const __m256d t2 = _mm256_add_pd(a1, a3);
+			const __m256d t3 = _mul_neg_i_f64(_mm256_sub_pd(a1, a3));
+			_mm256_storeu_pd(y0 + q, _mm256_add_pd(t0, t2));
+			_mm256_storeu_pd(y0 + 2*s + q, _mul_f64(_mm256_add_pd(t1, t3), w1_re, w1_im));
+			_mm256_storeu_pd(y0 + 4*s + q, _mul_f64(_mm256_sub_pd(t0, t2), w2_re, w2_im));
+			_mm256_storeu_pd(y0 + 6*s + q, _mul_f64(_mm256_sub_pd(t1, t3), w3_re, w3_im));
+		}
+	}
+}
+
+__attribute__((target("avx2,fma")))
+void
+_butterfly4_f32_avx2(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s)
+{
+	if (s % 4 != 0)
+		return impl_fft::_butterfly4<float>(x, y, w, m, s);
+
+	const float* src = reinterpret_cast<const float*>(x);
+	float* dst = reinterpret_cast<float*>(y);
+	for (size_t p = 0; p < m; ++p) {
+		const __m256 w1_re = _mm256_set1_ps(w[p].real());
+		const __m256 w1_im = _mm256_set1_ps(w[p].imag());
+		const __m256 w2_re = _mm256_set1_ps(w[m + p].real());
+		const __m256 w2_im = _mm256_set1_ps(w[m + p].imag());
+		const __m256 w3_re = _mm256_set1_ps(w[2*m + p].real());
+		const __m256 w3_im = _mm256_set1_ps(w[2*m + p].imag());
+		const float* x0 = src + 2*s*p;
+		const float* x1 = src + 2*s*(p + m);
+		const float* x2 = src + 2*s*(p + 2*m);
+		const float* x3 = src + 2*s*(p + 3*m);
+		float* y0 = dst + 2*s*(4*p);
+		for (size_t q = 0; q < 2*s; q += 8) {
+			const __m256 a0 = _mm256_loadu_ps(x0 + q);
+			const __m256 a1 = _mm256_loadu_ps(x1 + q);
+			const __m256 a2 = _mm256_loadu_ps(x2 + q);
+			const __m256 a3 = _mm256_loadu_ps(x3 + q);
+			const __m256 t0 = _mm256_add_ps(a0, a2);
+			const __m256 t1 = _mm256_sub_ps(a0, a2);
+			const __m256 t2 = _mm256_add_ps(a1, a3);
+			const __m256 t3 = _mul_neg_i_f32(_mm256_sub_ps(a1, a3));
+			_mm256_storeu_ps(y0 + q, _mm256_add_ps(t0, t2));
+			_mm256_storeu_ps(y0 + 2*s + q, _mul_f32(_mm256_add_ps(t1, t3), w1_re, w1_im));
+			_mm256_storeu_ps(y0 + 4*s + q, _mul_f32(_mm256_sub_ps(t0, t2), w2_re, w2_im));
+			_mm256_storeu_ps(y0 + 6*s + q, _mul_f32(_mm256_sub_ps(t1, t3), w3_re, w3_im));
+		}
+	}
+}
+
+bool
+_has_avx2()
+{
+	return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"));
+}
+
+#endif
+
+} // namespace
+
+
+
+void
+_butterfly2(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s)
+{
+#ifdef MTK_IMPL_FFT_X86
+	static const _butterfly_fn<float> fn = (_has_avx2() ? &_butterfly2_f32_avx2 : &impl_fft::_butterfly2<float>);
+#else
+	static const _butterfly_fn<float> fn = &impl_fft::_butterfly2<float>;
+#endif
+	fn(x, y, w, m, s);
+}
+
+void
+_butterfly2(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s)
+{
+#ifdef MTK_IMPL_FFT_X86
+	static const _butterfly_fn<double> fn = (_has_avx2() ? &_butterfly2_f64_avx2 : &impl_fft::_butterfly2<double>);
+#else
+	static const _butterfly_fn<double> fn = &impl_fft::_butterfly2<double>;
+#endif
+	fn(x, y, w, m, s);
+}
+
+void
+_butterfly4(const std::complex<float>* x, std::complex<float>* y, const std::complex<float>* w, size_t m, size_t s)
+{
+#ifdef MTK_IMPL_FFT_X86
+	static const _butterfly_fn<float> fn = (_has_avx2() ? &_butterfly4_f32_avx2 : &impl_fft::_butterfly4<float>);
+#else
+	static const _butterfly_fn<float> fn = &impl_fft::_butterfly4<float>;
+#endif
+	fn(x, y, w, m, s);
+}
+
+void
+_butterfly4(const std::complex<double>* x, std::complex<double>* y, const std::complex<double>* w, size_t m, size_t s)
+{
+#ifdef MTK_IMPL_FFT_X86
+	static const _butterfly_fn<double> fn = (_has_avx2() ? &_butterfly4_f64_avx2 : &impl_fft::_butterfly4<double>);
+#else
+	static const _butterfly_fn<double> fn = &impl_fft::_butterfly4<double>;
+#endif
+	fn(x, y, w, m, s);
+}
+
+} // namespace impl_fft
+} // namespace mtk
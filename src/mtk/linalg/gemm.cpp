@@ -0,0 +1,316 @@
+#include <mtk/linalg/gemm.hpp>
+
+#include <mtk/core/types.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define MTK_IMPL_GEMM_X86
+	#include <immintrin.h>
+#endif
+
+namespace mtk {
+namespace impl_gemm {
+namespace {
+
+using _dot_s8_fn = int32_t(*)(const int8_t*, const int8_t*, size_t);
+
+template<class T>
+using _axpy_complex_fn = void(*)(std::complex<T>, const std::complex<T>*, std::complex<T>*, size_t);
+
+template<class T>
+using _dotu_complex_fn = std::complex<T>(*)(const std::complex<T>*, const std::complex<T>*, size_t);
+
+int32_t
+_dot_s8_scalar(const int8_t* a, const int8_t* b, size_t n)
+{
+	int32_t sum = 0;
+	for (size_t i = 0; i < n; ++i)
+		sum += int32_t(a[i])*int32_t(b[i]);
+
+	return sum;
+}
+
+#ifdef MTK_IMPL_GEMM_X86
+
+__attribute__((target("avx2")))
+int32_t
+_hsum_avx2(__m256i v)
+{
+	__m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(s);
+}
+
+// maddubs saturates for the full s8 x s8 range, so the AVX2 path widens
+// to 16 bits and uses madd, which is exact.
+__attribute__((target("avx2")))
+int32_t
+_dot_s8_avx2(const int8_t* a, const int8_t* b, size_t n)
+{
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		const __m256i a_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(va));
+		const __m256i a_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(va, 1));
+		const __m256i b_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb));
+		const __m256i b_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1));
+		acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a_lo, b_lo));
+		acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a_hi, b_hi));
+	}
+
+	return _hsum_avx2(_mm256_add_epi32(acc0, acc1)) + _dot_s8_scalar(a + i, b + i, n - i);
+}
+
+// Extracts both halves zero masked, _mm512_reduce_add_epi32 and _mm512_castsi512_si256
+// make GCC 12 warn about the undefined pass-through operand of the unmasked extract.
+__attribute__((target("avx512f,avx2")))
+int32_t
+_hsum_avx512(__m512i v)
+{
+	const __m256i lo = _mm512_maskz_extracti64x4_epi64(0xF, v, 0);
+	const __m256i hi = _mm512_maskz_extracti64x4_epi64(0xF, v, 1);
+	return _hsum_avx2(_mm256_add_epi32(lo, hi));
+}
+
+// dpbusd multiplies unsigned by signed bytes. a is biased to unsigned by
+// flipping the sign bit, a + 128, and 128*sum(b) is subtracted afterwards.
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+int32_t
+_dot_s8_avx512_vnni(const int8_t* a, const int8_t* b, size_t n)
+{
+	const __m512i bias = _mm512_set1_epi8(static_cast<char>(0x80));
+	const __m512i ones = _mm512_set1_epi8(1);
+	__m512i acc = _mm512_setzero_si512();
+	__m512i b_sum = _mm512_setzero_si512();
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		const __m512i va = _mm512_xor_si512(_mm512_loadu_si512(a + i), bias);
+		const __m512i vb = _mm512_loadu_si512(b + i);
+		acc = _mm512_dpbusd_epi32(acc, va, vb);
+		b_sum = _mm512_dpbusd_epi32(b_sum, ones, vb);
+	}
+
+	const int32_t sum = _hsum_avx512(acc) - 128*_hsum_avx512(b_sum);
+	return sum + _dot_s8_scalar(a + i, b + i, n - i);
+}
+
+// Complex values stay interleaved as (re, im) pairs. For axpy the real part of a
+// multiplies x as is and the imaginary part multiplies x with re and im swapped,
+// its sign alternating so the even lanes subtract.
+__attribute__((target("avx2,fma")))
+void
+_axpy_complex_f64_avx2(std::complex<double> a, const std::complex<double>* x, std::complex<double>* y, size_t n)
+{
+	const __m256d a_re = _mm256_set1_pd(a.real());
+	const __m256d a_im = _mm256_set_pd(a.imag(), -a.imag(), a.imag(), -a.imag());
+	const double* src = reinterpret_cast<const double*>(x);
+	double* dst = reinterpret_cast<double*>(y);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256d x0 = _mm256_loadu_pd(src + 2*i);
+		const __m256d x1 = _mm256_loadu_pd(src + 2*i + 4);
+		__m256d y0 = _mm256_fmadd_pd(x0, a_re, _mm256_loadu_pd(dst + 2*i));
+		__m256d y1 = _mm256_fmadd_pd(x1, a_re, _mm256_loadu_pd(dst + 2*i + 4));
+		y0 = _mm256_fmadd_pd(_mm256_permute_pd(x0, 0x5), a_im, y0);
+		y1 = _mm256_fmadd_pd(_mm256_permute_pd(x1, 0x5), a_im, y1);
+		_mm256_storeu_pd(dst + 2*i, y0);
+		_mm256_storeu_pd(dst + 2*i + 4, y1);
+	}
+
+	impl_gemm::_axpy<std::complex<double>>(a, x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+void
+_axpy_complex_f32_avx2(std::complex<float> a, const std::complex<float>* x, std::complex<float>* y, size_t n)
+{
+	const __m256 a_re = _mm256_set1_ps(a.real());
+	const __m256 a_im = _mm256_set_ps(a.imag(), -a.imag(), a.imag(), -a.imag(), a.imag(), -a.imag(), a.imag(), -a.imag());
+	const float* src = reinterpret_cast<const float*>(x);
+	float* dst = reinterpret_cast<float*>(y);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256 x0 = _mm256_loadu_ps(src + 2*i);
+		const __m256 x1 = _mm256_loadu_ps(src + 2*i + 8);
+		__m256 y0 = _mm256_fmadd_ps(x0, a_re, _mm256_loadu_ps(dst + 2*i));
+		__m256 y1 = _mm256_fmadd_ps(x1, a_re, _mm256_loadu_ps(dst + 2*i + 8));
+		y0 = _mm256_fmadd_ps(_mm256_permute_ps(x0, 0xb1), a_im, y0);
+		y1 = _mm256_fmadd_ps(_mm256_permute_ps(x1, 0xb1), a_im, y1);
+		_mm256_storeu_ps(dst + 2*i, y0);
+		_mm256_storeu_ps(dst + 2*i + 8, y1);
+	}
+
+	impl_gemm::_axpy<std::complex<float>>(a, x + i, y + i, n - i);
+}
+
+// The products x*y and x*swap(y) are accumulated lane wise, the real part is
+// the even minus the odd lanes of the first and the imaginary part the sum of the second.
+__attribute__((target("avx2,fma")))
+std::complex<double>
+_dotu_complex_f64_avx2(const std::complex<double>* x, const std::complex<double>* y, size_t n)
+{
+	const double* lhs = reinterpret_cast<const double*>(x);
+	const double* rhs = reinterpret_cast<const double*>(y);
+	__m256d acc_re = _mm256_setzero_pd();
+	__m256d acc_im = _mm256_setzero_pd();
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		const __m256d a = _mm256_loadu_pd(lhs + 2*i);
+		const __m256d b = _mm256_loadu_pd(rhs + 2*i);
+		acc_re = _mm256_fmadd_pd(a, b, acc_re);
+		acc_im = _mm256_fmadd_pd(a, _mm256_permute_pd(b, 0x5), acc_im);
+	}
+
+	alignas(32) double re[4];
+	alignas(32) double im[4];
+	_mm256_store_pd(re, acc_re);
+	_mm256_store_pd(im, acc_im);
+	const std::complex<double> sum(re[0] - re[1] + re[2] - re[3], im[0] + im[1] + im[2] + im[3]);
+	return sum + impl_gemm::_dotu<std::complex<double>>(x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+std::complex<float>
+_dotu_complex_f32_avx2(const std::complex<float>* x, const std::complex<float>* y, size_t n)
+{
+	const float* lhs = reinterpret_cast<const float*>(x);
+	const float* rhs = reinterpret_cast<const float*>(y);
+	__m256 acc_re = _mm256_setzero_ps();
+	__m256 acc_im = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256 a = _mm256_loadu_ps(lhs + 2*i);
+		const __m256 b = _mm256_loadu_ps(rhs + 2*i);
+		acc_re = _mm256_fmadd_ps(a, b, acc_re);
+		acc_im = _mm256_fmadd_ps(a, _mm256_permute_ps(b, 0xb1), acc_im);
+	}
+
+	alignas(32) float re[8];
+	alignas(32) float im[8];
+	_mm256_store_ps(re, acc_re);
+	_mm256_store_ps(im, acc_im);
+	std::complex<float> sum;
+	for (size_t j = 0; j < 8; j += 2)
+		sum += std::complex<float>(re[j] - re[j + 1], im[j] + im[j + 1]);
+
+	return sum + impl_gemm::_dotu<std::complex<float>>(x + i, y + i, n - i);
+}
+
+#endif
+
+_axpy_complex_fn<float>
+_select_axpy_complex_f32()
+{
+#ifdef MTK_IMPL_GEMM_X86
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return &_axpy_complex_f32_avx2;
+#endif
+	return &impl_gemm::_axpy<std::complex<float>>;
+}
+
+_axpy_complex_fn<double>
+_select_axpy_complex_f64()
+{
+#ifdef MTK_IMPL_GEMM_X86
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return &_axpy_complex_f64_avx2;
+#endif
+	return &impl_gemm::_axpy<std::complex<double>>;
+}
+
+_dotu_complex_fn<float>
+_select_dotu_complex_f32()
+{
+#ifdef MTK_IMPL_GEMM_X86
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return &_dotu_complex_f32_avx2;
+#endif
+	return &impl_gemm::_dotu<std::complex<float>>;
+}
+
+_dotu_complex_fn<double>
+_select_dotu_complex_f64()
+{
+#ifdef MTK_IMPL_GEMM_X86
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return &_dotu_complex_f64_avx2;
+#endif
+	return &impl_gemm::_dotu<std::complex<double>>;
+}
+
+_dot_s8_fn
+_select_dot_s8()
+{
+#ifdef MTK_IMPL_GEMM_X86
+	if (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw"))
+		return &_dot_s8_avx512_vnni;
+	if (__builtin_cpu_supports("avx2"))
+		return &_dot_s8_avx2;
+#endif
+	return &_dot_s8_scalar;
+}
+
+_dot_s8_fn
+_dot_s8()
+{
+	static const auto fn = _select_dot_s8();
+	return fn;
+}
+
+} // namespace
+
+
+
+void
+_gemm_s8(const int8_t* a, size_t lda, const int8_t* bt, size_t ldb, int32_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+	const auto dot = _dot_s8();
+	for (size_t i = 0; i < m; ++i) {
+		const int8_t* a_row = a + i*lda;
+		int32_t* c_row = c + i*ldc;
+		for (size_t j = 0; j < n; ++j)
+			c_row[j] = dot(a_row, bt + j*ldb, k);
+	}
+}
+
+void
+_gemv_s8(const int8_t* a, size_t lda, const int8_t* x, int32_t* y, size_t m, size_t k)
+{
+	const auto dot = _dot_s8();
+	for (size_t i = 0; i < m; ++i)
+		y[i] = dot(a + i*lda, x, k);
+}
+
+void
+_axpy(std::complex<float> a, const std::complex<float>* x, std::complex<float>* y, size_t n)
+{
+	static const auto fn = _select_axpy_complex_f32();
+	fn(a, x, y, n);
+}
+
+void
+_axpy(std::complex<double> a, const std::complex<double>* x, std::complex<double>* y, size_t n)
+{
+	static const auto fn = _select_axpy_complex_f64();
+	fn(a, x, y, n);
+}
+
+std::complex<float>
+_dotu(const std::complex<float>* x, const std::complex<float>* y, size_t n)
+{
+	static const auto fn = _select_dotu_complex_f32();
+	return fn(x, y, n);
+}
+
+std::complex<double>
+_dotu(const std::complex<double>* x, const std::complex<double>* y, size_t n)
+{
+	static const auto fn = _select_dotu_complex_f64();
+	return fn(x, y, n);
+}
+
+} // namespace impl_gemm
+} // namespace mtk
@@ -0,0 +1,103 @@
+#include <mtk/linalg/quaternion.hpp>
+
+#include <mtk/core/assert.hpp>
+#include <mtk/core/types.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define MTK_IMPL_QUATERNION_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace mtk {
+namespace impl_quaternion {
+namespace {
+
+void
+_transform_scalar(const float (&rot)[9], const float* src, float* dst, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		const float x = src[3*i + 0];
+		const float y = src[3*i + 1];
+		const float z = src[3*i + 2];
+		dst[3*i + 0] = rot[0]*x + rot[1]*y + rot[2]*z;
+		dst[3*i + 1] = rot[3]*x + rot[4]*y + rot[5]*z;
+		dst[3*i + 2] = rot[6]*x + rot[7]*y + rot[8]*z;
+	}
+}
+
+#ifdef MTK_IMPL_QUATERNION_SSE
+
+// Four packed vectors occupy three registers, a = x0 y0 z0 x1, b = y1 z1 x2 y2
+// and c = z2 x3 y3 z3. They are shuffled into x, y and z registers, rotated
+// as structure of arrays, and shuffled back.
+void
+_transform_sse(const float (&rot)[9], const float* src, float* dst, size_t count)
+{
+	__m128 r[9];
+	for (size_t i = 0; i < 9; ++i)
+		r[i] = _mm_set1_ps(rot[i]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 a = _mm_loadu_ps(src + 3*i);
+		const __m128 b = _mm_loadu_ps(src + 3*i + 4);
+		const __m128 c = _mm_loadu_ps(src + 3*i + 8);
+
+		const __m128 bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		const __m128 x = _mm_shuffle_ps(a, bc, _MM_SHUFFLE(2, 0, 3, 0));
+		const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), bc, _MM_SHUFFLE(3, 1, 2, 0));
+		const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], x), _mm_mul_ps(r[1], y)), _mm_mul_ps(r[2], z));
+		const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[3], x), _mm_mul_ps(r[4], y)), _mm_mul_ps(r[5], z));
+		const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[6], x), _mm_mul_ps(r[7], y)), _mm_mul_ps(r[8], z));
+
+		const __m128 xy = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m128 zx = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+		const __m128 yz = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(2, 1, 2, 1));
+		const __m128 xy2 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 zx3 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 3, 2));
+		const __m128 yz3 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+		_mm_storeu_ps(dst + 3*i, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + 3*i + 4, _mm_shuffle_ps(yz, xy2, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + 3*i + 8, _mm_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	_transform_scalar(rot, src + 3*i, dst + 3*i, count - i);
+}
+
+#endif
+
+} // namespace
+} // namespace impl_quaternion
+
+
+
+void
+rotate(const quaternion<float>& q, span<const vector<float, 3>> src, span<vector<float, 3>> dst)
+{
+	MTK_ASSERT(src.size() == dst.size());
+	static_assert(sizeof(vector<float, 3>) == 3*sizeof(float));
+
+	const auto m = q.to_matrix3();
+	const float rot[9] = {
+		m.value(0, 0), m.value(0, 1), m.value(0, 2),
+		m.value(1, 0), m.value(1, 1), m.value(1, 2),
+		m.value(2, 0), m.value(2, 1), m.value(2, 2)};
+
+	const float* src_data = src.empty() ? nullptr : src[0].data();
+	float* dst_data = dst.empty() ? nullptr : dst[0].data();
+#ifdef MTK_IMPL_QUATERNION_SSE
+	impl_quaternion::_transform_sse(rot, src_data, dst_data, src.size());
+#else
+	impl_quaternion::_transform_scalar(rot, src_data, dst_data, src.size());
+#endif
+}
+
+void
+rotate(const quaternion<float>& q, span<vector<float, 3>> vecs)
+{
+	mtk::rotate(q, span<const vector<float, 3>>(vecs.data(), vecs.size()), vecs);
+}
+
+} // namespace mtk